@@ -0,0 +1,301 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/transpose_64x64.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Column of Bits wide unsigned values stored bit sliced (also
+///        called vertical or BitWeaving/V storage).
+///
+/// The values are stored in groups of 64. For each group the column holds
+/// one word per bit of the values, the bit plane, where bit i of plane k is
+/// bit k of value i in the group. A scan over a 5 bit field thereby reads
+/// 5 words per 64 values and only the planes it needs:
+///
+///     group 0: | plane 4 (MSB) | plane 3 | ... | plane 0 (LSB) |
+///     group 1: | plane 4 (MSB) | plane 3 | ... | plane 0 (LSB) |
+///
+/// The predicates compare 64 values at a time starting from the most
+/// significant plane and stop as soon as all values of the group differ
+/// from the constant. The result is a bitmap with one bit per value (LSB 0
+/// numbering within each word), see result_words().
+template<uint32_t Bits>
+class bit_sliced_column
+{
+public:
+
+    static_assert(Bits > 0 && Bits <= 64, "Bits must be between 1 and 64");
+
+    /// @brief Builds the column
+    /// @param values is the values to store, each must fit in Bits bits
+    /// @param count is the number of values
+    template<class Type>
+    bit_sliced_column(const Type* values, uint64_t count) :
+        bit_sliced_column(count, [values](uint64_t index)
+    {
+        return values[index];
+    })
+    {
+        assert(values != nullptr || count == 0);
+    }
+
+    /// @brief Builds the column from a function returning the values
+    /// @param count is the number of values
+    /// @param value is called as value(index) for every index below count
+    ///        and must return a value which fits in Bits bits
+    template<class Function>
+    bit_sliced_column(uint64_t count, Function value) :
+        m_size(count),
+        m_planes(((count + 63) / 64) * Bits, 0)
+    {
+        uint64_t rows[64];
+
+        for (uint64_t group = 0; group < groups(); ++group)
+        {
+            for (uint64_t i = 0; i < 64; ++i)
+            {
+                uint64_t index = group * 64 + i;
+                rows[i] = index < count ? uint64_t(value(index)) : 0;
+
+                assert((rows[i] & ~max_value()) == 0 &&
+                       "value exceeds limit representable by available bits");
+            }
+
+            // After the transpose row k holds bit k of the 64 values
+            transpose_64x64(rows);
+
+            uint64_t* planes = m_planes.data() + group * Bits;
+
+            for (uint32_t k = 0; k < Bits; ++k)
+            {
+                planes[k] = rows[Bits - 1 - k];
+            }
+        }
+    }
+
+    /// @return The number of values
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return The number of words needed for a result bitmap
+    uint64_t result_words() const
+    {
+        return groups();
+    }
+
+    /// @return The value at index
+    uint64_t at(uint64_t index) const
+    {
+        assert(index < m_size);
+
+        const uint64_t* planes = m_planes.data() + (index / 64) * Bits;
+        uint64_t value = 0;
+
+        for (uint32_t k = 0; k < Bits; ++k)
+        {
+            value = (value << 1) | ((planes[k] >> (index % 64)) & 1U);
+        }
+
+        return value;
+    }
+
+    /// @brief Finds the values equal to value
+    /// @param result is the bitmap of result_words() words to write to
+    void equal(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return equal;
+        });
+    }
+
+    /// @brief Finds the values different from value
+    /// @param result is the bitmap of result_words() words to write to
+    void not_equal(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return ~equal;
+        });
+    }
+
+    /// @brief Finds the values less than value
+    /// @param result is the bitmap of result_words() words to write to
+    void less(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return less;
+        });
+    }
+
+    /// @brief Finds the values less than or equal to value
+    /// @param result is the bitmap of result_words() words to write to
+    void less_equal(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return less | equal;
+        });
+    }
+
+    /// @brief Finds the values greater than value
+    /// @param result is the bitmap of result_words() words to write to
+    void greater(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return ~(less | equal);
+        });
+    }
+
+    /// @brief Finds the values greater than or equal to value
+    /// @param result is the bitmap of result_words() words to write to
+    void greater_equal(uint64_t value, uint64_t* result) const
+    {
+        scan(result, [this, value](uint64_t group)
+        {
+            uint64_t less;
+            uint64_t equal;
+            compare(group, value, less, equal);
+            return ~less;
+        });
+    }
+
+    /// @brief Finds the values in the range [low, high]
+    /// @param result is the bitmap of result_words() words to write to
+    void between(uint64_t low, uint64_t high, uint64_t* result) const
+    {
+        scan(result, [this, low, high](uint64_t group)
+        {
+            uint64_t less_low;
+            uint64_t equal_low;
+            compare(group, low, less_low, equal_low);
+
+            uint64_t less_high;
+            uint64_t equal_high;
+            compare(group, high, less_high, equal_high);
+
+            return ~less_low & (less_high | equal_high);
+        });
+    }
+
+private:
+
+    /// @return The number of groups of 64 values
+    uint64_t groups() const
+    {
+        return m_planes.size() / Bits;
+    }
+
+    /// @return The largest value representable in Bits bits
+    static constexpr uint64_t max_value()
+    {
+        return ~uint64_t{0} >> (64 - Bits);
+    }
+
+    /// @brief Compares the values of a group with value
+    /// @param less is set to the bitmap of values less than value
+    /// @param equal is set to the bitmap of values equal to value
+    void compare(uint64_t group, uint64_t value,
+                 uint64_t& less, uint64_t& equal) const
+    {
+        if (value > max_value())
+        {
+            less = ~uint64_t{0};
+            equal = 0;
+            return;
+        }
+
+        const uint64_t* planes = m_planes.data() + group * Bits;
+
+        less = 0;
+        equal = ~uint64_t{0};
+
+        // Once no value is equal to the prefix of the constant all values
+        // are decided and the remaining planes need not be read
+        for (uint32_t k = 0; k < Bits && equal != 0; ++k)
+        {
+            // All ones if the bit of the constant is set
+            uint64_t bit = 0 - ((value >> (Bits - 1 - k)) & 1U);
+
+            less |= equal & ~planes[k] & bit;
+            equal &= ~(planes[k] ^ bit);
+        }
+    }
+
+    /// @brief Writes function(group) to the result of every group and
+    ///        clears the bits past the last value
+    template<class Function>
+    void scan(uint64_t* result, Function function) const
+    {
+        assert(result != nullptr || m_size == 0);
+
+        for (uint64_t group = 0; group < groups(); ++group)
+        {
+            result[group] = function(group);
+        }
+
+        if ((m_size % 64) != 0)
+        {
+            result[groups() - 1] &= (uint64_t{1} << (m_size % 64)) - 1;
+        }
+    }
+
+private:
+
+    /// The number of values
+    uint64_t m_size;
+
+    /// The bit planes of the groups, most significant plane first
+    std::vector<uint64_t> m_planes;
+};
+
+/// @brief Builds a bit sliced column of a single field of a layout, e.g.
+///        a column of the 9 bit field of an array of packed records:
+///
+///     using record = bitter::lsb0_layout<uint32_t, 9, 23>;
+///     auto column = bitter::slice_field<record, 0>(records, count);
+///
+/// @param data is the values of the layout
+/// @param count is the number of values
+template<class Layout, uint32_t Index>
+bit_sliced_column<Layout::template field_size<Index>()>
+slice_field(const typename Layout::value_type* data, uint64_t count)
+{
+    assert(data != nullptr || count == 0);
+
+    return bit_sliced_column<Layout::template field_size<Index>()>(
+        count, [data](uint64_t index)
+    {
+        return Layout::template get<Index>(data[index]);
+    });
+}
+}
@@ -0,0 +1,216 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/bit_buffer.hpp"
+
+#include "lsb0.hpp"
+#include "msb0.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Reader class used for reading a stream of bits from a byte
+///        buffer. The BitNumbering decides whether the bits of each byte
+///        are read starting from the most significant bit (msb0) or the
+///        least significant bit (lsb0).
+///
+/// The next bits of the stream are kept in a 64 bit buffer which is
+/// refilled with a single unaligned load, so after a refill() at least 56
+/// bits can be peeked and consumed without touching memory again.
+///
+/// Reading or skipping past the end of the data, or a decoder finding an
+/// invalid code (see fail()), makes the reader invalid: the rest of the
+/// data is dropped and further reads return zero. Decoders of untrusted
+/// data should check is_valid() after decoding.
+template<class BitNumbering>
+class bit_stream_reader
+{
+public:
+
+    /// Small alias for the buffer operations
+    using buffer = detail::bit_buffer<BitNumbering>;
+
+    /// The number of bits which are guaranteed to be buffered after a
+    /// refill() unless the end of the data is reached
+    static constexpr uint32_t refill_bits = 56;
+
+    /// @brief Reader constructor
+    /// @param data is the buffer to read from
+    /// @param size is the size of the buffer in bytes
+    bit_stream_reader(const uint8_t* data, uint64_t size) :
+        m_data(data),
+        m_end(data + size)
+    {
+        assert(data != nullptr || size == 0);
+    }
+
+    /// @brief Fills the bit buffer such that it holds at least refill_bits
+    ///        bits or the remaining bits of the data
+    void refill()
+    {
+        if (m_end - m_data >= 8)
+        {
+            // Branchless refill: Load 8 bytes but only count the whole
+            // bytes that fit. The bits of the partial byte are loaded
+            // again (to the same position) by the next refill.
+            m_buffer = buffer::append(m_buffer, m_count, buffer::load(m_data));
+
+            uint32_t bytes = (63 - m_count) >> 3;
+            m_data += bytes;
+            m_count += bytes * 8;
+        }
+        else
+        {
+            while (m_count <= refill_bits && m_data != m_end)
+            {
+                m_buffer = buffer::append_byte(m_buffer, m_count, *m_data);
+                m_data += 1;
+                m_count += 8;
+            }
+        }
+    }
+
+    /// @return False if a read went past the end of the data or fail()
+    ///         was called
+    bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    /// @brief Makes the reader invalid and drops the rest of the data, used
+    ///        by decoders finding an invalid code
+    void fail()
+    {
+        m_valid = false;
+        m_data = m_end;
+        m_buffer = 0;
+        m_count = 0;
+    }
+
+    /// @return The number of bits in the bit buffer
+    uint32_t buffered_bits() const
+    {
+        return m_count;
+    }
+
+    /// @return The number of bits left in the stream
+    uint64_t bits_left() const
+    {
+        return static_cast<uint64_t>(m_end - m_data) * 8 + m_count;
+    }
+
+    /// @return The next bits in the buffer without consuming them. Bits
+    ///         past the end of the data are read as zero.
+    /// @param bits is the number of bits to peek, at most refill_bits
+    uint64_t peek(uint32_t bits) const
+    {
+        assert(bits > 0 && bits <= refill_bits);
+        return buffer::peek(m_buffer, bits);
+    }
+
+    /// @brief Consumes bits from the buffer
+    /// @param bits is the number of bits to consume, at most
+    ///        buffered_bits()
+    void consume(uint32_t bits)
+    {
+        assert(bits <= m_count && "Consuming more bits than buffered");
+        m_buffer = buffer::consume(m_buffer, bits);
+        m_count -= bits;
+    }
+
+    /// @return The number of zero bits before the next one bit in the
+    ///         buffer. If the buffer has no one bits buffered_bits() is
+    ///         returned.
+    uint32_t count_zeros() const
+    {
+        uint32_t zeros = buffer::zeros(m_buffer);
+        return zeros < m_count ? zeros : m_count;
+    }
+
+    /// @return The next bits read from the stream, in msb0 mode the first
+    ///         bit is the most significant and in lsb0 mode the least
+    ///         significant bit of the value
+    /// @param bits is the number of bits to read, at most 64
+    uint64_t read(uint32_t bits)
+    {
+        assert(bits <= 64);
+
+        if (bits == 0)
+        {
+            return 0;
+        }
+
+        if (bits > refill_bits)
+        {
+            uint64_t first = read(bits - 32);
+            uint64_t second = read(32);
+            return buffer::combine(first, bits - 32, second, 32);
+        }
+
+        if (m_count < bits)
+        {
+            refill();
+
+            if (m_count < bits)
+            {
+                // Reading past the end of the data
+                fail();
+                return 0;
+            }
+        }
+
+        uint64_t value = buffer::peek(m_buffer, bits);
+        consume(bits);
+        return value;
+    }
+
+    /// @brief Skips a number of bits in the stream
+    void skip(uint64_t bits)
+    {
+        if (bits > bits_left())
+        {
+            // Skipping past the end of the data
+            fail();
+            return;
+        }
+
+        while (bits > 0)
+        {
+            if (m_count == 0)
+            {
+                refill();
+            }
+
+            uint32_t step = bits < m_count ? static_cast<uint32_t>(bits) :
+                            m_count;
+            consume(step);
+            bits -= step;
+        }
+    }
+
+private:
+
+    /// The next byte to load into the bit buffer
+    const uint8_t* m_data;
+
+    /// The end of the data
+    const uint8_t* m_end;
+
+    /// The bit buffer
+    uint64_t m_buffer = 0;
+
+    /// The number of valid bits in the bit buffer
+    uint32_t m_count = 0;
+
+    /// False once a read went past the end of the data
+    bool m_valid = true;
+};
+
+template<class BitNumbering>
+constexpr uint32_t bit_stream_reader<BitNumbering>::refill_bits;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/bit_buffer.hpp"
+
+#include "lsb0.hpp"
+#include "msb0.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Writer class used for writing a stream of bits to a byte
+///        buffer. The BitNumbering decides whether the bits of each byte
+///        are written starting from the most significant bit (msb0) or the
+///        least significant bit (lsb0), see bit_stream_reader.
+template<class BitNumbering>
+class bit_stream_writer
+{
+public:
+
+    /// Small alias for the buffer operations
+    using buffer = detail::bit_buffer<BitNumbering>;
+
+    /// @brief Writer constructor
+    /// @param data is the buffer to write to
+    /// @param size is the size of the buffer in bytes
+    bit_stream_writer(uint8_t* data, uint64_t size) :
+        m_begin(data),
+        m_data(data),
+        m_end(data + size)
+    {
+        assert(data != nullptr || size == 0);
+    }
+
+    /// @brief Writes the bits of value to the stream
+    /// @param value is the value to write, it must be representable with
+    ///        the given number of bits
+    /// @param bits is the number of bits to write, at most 64
+    void write(uint64_t value, uint32_t bits)
+    {
+        assert(bits <= 64);
+        assert((bits == 64 || (value >> bits) == 0) &&
+               "value exceeds limit representable by available bits");
+
+        if (bits == 0)
+        {
+            return;
+        }
+
+        if (bits > 56)
+        {
+            uint64_t first;
+            uint64_t second;
+            buffer::split(value, bits - 32, 32, first, second);
+            write(first, bits - 32);
+            write(second, 32);
+            return;
+        }
+
+        m_accumulator = buffer::push(m_accumulator, m_count, value, bits);
+        m_count += bits;
+
+        while (m_count >= 8)
+        {
+            assert(m_data != m_end && "Writing past the end of the buffer");
+
+            *m_data = buffer::front_byte(m_accumulator, m_count);
+            m_accumulator = buffer::pop_byte(m_accumulator, m_count);
+            m_data += 1;
+            m_count -= 8;
+        }
+    }
+
+    /// @brief Writes any remaining bits padding the last byte with zeros
+    void flush()
+    {
+        if (m_count > 0)
+        {
+            assert(m_data != m_end && "Writing past the end of the buffer");
+
+            *m_data = buffer::pad_byte(m_accumulator, m_count);
+            m_data += 1;
+            m_accumulator = 0;
+            m_count = 0;
+        }
+    }
+
+    /// @return The number of bits written to the stream
+    uint64_t bits_written() const
+    {
+        return static_cast<uint64_t>(m_data - m_begin) * 8 + m_count;
+    }
+
+    /// @return The number of bytes needed for the written bits i.e. the
+    ///         size of the data after flush()
+    uint64_t size() const
+    {
+        return (bits_written() + 7) / 8;
+    }
+
+private:
+
+    /// The start of the buffer
+    uint8_t* m_begin;
+
+    /// The next byte to write in the buffer
+    uint8_t* m_data;
+
+    /// The end of the buffer
+    uint8_t* m_end;
+
+    /// The bits not yet written to the buffer
+    uint64_t m_accumulator = 0;
+
+    /// The number of bits in the accumulator
+    uint32_t m_count = 0;
+};
+}
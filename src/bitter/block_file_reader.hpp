@@ -0,0 +1,460 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/block_file_format.hpp"
+#include "detail/packed_bits.hpp"
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Source of a block_file_reader reading the words of a file held
+///        in memory, e.g. mapped with mmap. Nothing is copied.
+class memory_source
+{
+public:
+
+    /// @brief Source constructor
+    /// @param data is the words of the file, they must stay valid for the
+    ///        lifetime of the source
+    /// @param size is the number of words of the file
+    memory_source(const uint64_t* data, uint64_t size) :
+        m_data(data),
+        m_size(size)
+    {
+        assert(data != nullptr || size == 0);
+    }
+
+    /// @return The number of words of the file
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return The words of the file starting at offset, or nullptr if
+    ///         they are not all within the file
+    /// @param offset is the offset in words
+    /// @param words is the number of words to read
+    /// @param buffer is not used
+    const uint64_t* read(uint64_t offset, uint64_t words,
+                         std::vector<uint64_t>& buffer) const
+    {
+        (void) buffer;
+
+        if (offset > m_size || words > m_size - offset)
+        {
+            return nullptr;
+        }
+
+        return m_data + offset;
+    }
+
+private:
+
+    /// The words of the file
+    const uint64_t* m_data;
+
+    /// The number of words of the file
+    uint64_t m_size;
+};
+
+/// @brief Source of a block_file_reader reading the words of a file with a
+///        function, e.g. wrapping pread:
+///
+///     auto source = bitter::make_callback_source(
+///         [fd](uint64_t offset, uint64_t size, void* buffer)
+///         {
+///             return pread(fd, buffer, size, offset) == ssize_t(size);
+///         }, file_size);
+///
+/// A pread may return fewer bytes than asked for without an error, a
+/// function reading large files should loop until all are read.
+template<class Function>
+class callback_source
+{
+public:
+
+    /// @brief Source constructor
+    /// @param function is invoked as function(offset, size, buffer) to
+    ///        read size bytes at the byte offset into the buffer and must
+    ///        return true if all size bytes were read
+    /// @param bytes is the size of the file in bytes
+    callback_source(Function function, uint64_t bytes) :
+        m_function(std::move(function)),
+        m_size(bytes / sizeof(uint64_t))
+    {
+    }
+
+    /// @return The number of words of the file
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return The words of the file starting at offset read into buffer,
+    ///         or nullptr if the function failed to read them
+    /// @param offset is the offset in words
+    /// @param words is the number of words to read
+    /// @param buffer is the buffer to read into
+    const uint64_t* read(uint64_t offset, uint64_t words,
+                         std::vector<uint64_t>& buffer) const
+    {
+        buffer.resize(words);
+
+        if (!m_function(offset * sizeof(uint64_t), words * sizeof(uint64_t),
+                        static_cast<void*>(buffer.data())))
+        {
+            return nullptr;
+        }
+
+        return buffer.data();
+    }
+
+private:
+
+    /// The function reading the file
+    Function m_function;
+
+    /// The number of words of the file
+    uint64_t m_size;
+};
+
+/// @return A callback_source using function to read a file of bytes size
+template<class Function>
+callback_source<Function> make_callback_source(Function function,
+                                               uint64_t bytes)
+{
+    return callback_source<Function>(std::move(function), bytes);
+}
+
+/// @brief Reader of files written by a block_file_writer, scanning the
+///        records for a range of a field:
+///
+///     bitter::block_file_reader<record> reader(
+///         bitter::memory_source(file.data(), file.size()));
+///
+///     // All records with field 2 between 10 and 20
+///     reader.scan<2>(10, 20, [](uint64_t index, record::value_type value)
+///     {
+///         ...
+///     });
+///
+/// The header, zone maps and trailer are read when the reader is created. A scan
+/// skips every block where the zone map of the field does not overlap
+/// the range, and reads the other columns of a block only if a record of
+/// it matches. The bytes read and skipped are counted for every read
+/// through the source.
+template<class Layout, class Source = memory_source>
+class block_file_reader
+{
+public:
+
+    /// The integer type holding a record
+    using value_type = typename Layout::value_type;
+
+    /// @brief Reader constructor
+    /// @param source is the source of the file
+    explicit block_file_reader(Source source) :
+        m_source(std::move(source)),
+        m_columns(Layout::fields)
+    {
+        m_valid = open();
+
+        if (!m_valid)
+        {
+            m_records = 0;
+            m_block_records = 0;
+            m_blocks = 0;
+            m_zones.clear();
+        }
+    }
+
+    /// @return True if the source holds a block file of the layout and all
+    ///         reads succeeded. The header, the trailer and the size of the
+    ///         file are checked when the reader is created, and an invalid
+    ///         file reads as an empty one.
+    bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    /// @return The number of records
+    uint64_t records() const
+    {
+        return m_records;
+    }
+
+    /// @return The number of records in a block
+    uint64_t block_records() const
+    {
+        return m_block_records;
+    }
+
+    /// @return The number of blocks
+    uint64_t blocks() const
+    {
+        return m_blocks;
+    }
+
+    /// @return The minimum value of the field in the block
+    uint64_t zone_min(uint64_t block, uint32_t field) const
+    {
+        assert(block < m_blocks && field < Layout::fields);
+        return m_zones[format::zone_offset(block, field)];
+    }
+
+    /// @return The maximum value of the field in the block
+    uint64_t zone_max(uint64_t block, uint32_t field) const
+    {
+        assert(block < m_blocks && field < Layout::fields);
+        return m_zones[format::zone_offset(block, field) + 1];
+    }
+
+    /// @brief Invokes function(index, value) for every record where the
+    ///        field at Field is in the range low to high (both included),
+    ///        in the order of the records. If reading from the source fails
+    ///        the scan stops and the reader becomes invalid, see
+    ///        is_valid().
+    /// @return The number of matching records
+    template<uint32_t Field, class Function>
+    uint64_t scan(uint64_t low, uint64_t high, Function&& function)
+    {
+        static_assert(Field < Layout::fields, "Field index out of range");
+
+        const uint32_t size = Layout::template field_size<Field>();
+        const uint64_t block_bytes =
+            format::block_words(m_block_records) * sizeof(uint64_t);
+        const uint64_t column_bytes =
+            format::column_words(m_block_records, Field) * sizeof(uint64_t);
+
+        uint64_t matches = 0;
+        std::vector<uint32_t> rows;
+
+        for (uint64_t block = 0; block < m_blocks && m_valid; ++block)
+        {
+            if (zone_max(block, Field) < low || zone_min(block, Field) > high)
+            {
+                m_bytes_skipped += block_bytes;
+                continue;
+            }
+
+            const uint64_t* column = read_column(block, Field);
+
+            if (column == nullptr)
+            {
+                break;
+            }
+
+            uint64_t count = std::min(m_block_records,
+                                      m_records - block * m_block_records);
+
+            rows.clear();
+
+            for (uint64_t row = 0; row < count; ++row)
+            {
+                uint64_t value = read_bits(column, row * size, size);
+
+                if (value >= low && value <= high)
+                {
+                    rows.push_back(static_cast<uint32_t>(row));
+                }
+            }
+
+            if (rows.empty())
+            {
+                m_bytes_skipped += block_bytes - column_bytes;
+                continue;
+            }
+
+            // Read the other columns and assemble the matching records
+            const uint64_t* columns[Layout::fields];
+
+            for (uint32_t field = 0; field < Layout::fields; ++field)
+            {
+                columns[field] = field == Field ? column :
+                                 read_column(block, field);
+            }
+
+            if (!m_valid)
+            {
+                break;
+            }
+
+            for (uint32_t row : rows)
+            {
+                value_type value = 0;
+
+                for (uint32_t field = 0; field < Layout::fields; ++field)
+                {
+                    uint32_t bits = Layout::table::sizes[field];
+                    uint64_t field_value = read_bits(
+                        columns[field], uint64_t(row) * bits, bits);
+
+                    value = Layout::table::set(
+                        value, field, static_cast<value_type>(field_value));
+                }
+
+                function(block * m_block_records + row, value);
+            }
+
+            matches += rows.size();
+        }
+
+        return matches;
+    }
+
+    /// @return The number of bytes read through the source
+    uint64_t bytes_read() const
+    {
+        return m_bytes_read;
+    }
+
+    /// @return The number of bytes of blocks skipped by scans
+    uint64_t bytes_skipped() const
+    {
+        return m_bytes_skipped;
+    }
+
+private:
+
+    /// The layout of the file
+    using format = detail::block_file_format<Layout>;
+
+    /// Reads and checks the header, trailer and zone maps
+    /// @return True if the file is valid
+    bool open()
+    {
+        const uint64_t words = m_source.size();
+
+        if (words < format::header_words + format::trailer_words)
+        {
+            return false;
+        }
+
+        const uint64_t* header = read(0, format::header_words,
+                                      m_columns[0]);
+
+        // The layout of the file must be the layout of the reader
+        if (header == nullptr || header[0] != format::magic || header[1] == 0 ||
+            header[2] != Layout::fields || header[3] != Layout::bits)
+        {
+            return false;
+        }
+
+        m_block_records = header[1];
+
+        const uint64_t* trailer = read(words - format::trailer_words,
+                                       format::trailer_words, m_columns[0]);
+
+        if (trailer == nullptr || trailer[2] != format::magic)
+        {
+            return false;
+        }
+
+        m_records = trailer[0];
+        m_blocks = trailer[1];
+
+        if (m_blocks != m_records / m_block_records +
+            (m_records % m_block_records != 0 ? 1 : 0))
+        {
+            return false;
+        }
+
+        // A block is at least one bit per record, check the sizes against
+        // the file before computing offsets which could overflow
+        const uint64_t data_words =
+            words - format::header_words - format::trailer_words;
+
+        if (m_blocks > 0 &&
+            (m_block_records / 64 > data_words ||
+             m_blocks > data_words / format::block_words(m_block_records) ||
+             m_blocks > data_words / (Layout::fields * 2)))
+        {
+            return false;
+        }
+
+        if (format::file_words(m_block_records, m_blocks) != words)
+        {
+            return false;
+        }
+
+        uint64_t zone_words = format::zone_offset(m_blocks, 0);
+        const uint64_t* zones = read(
+            format::zones_offset(m_block_records, m_blocks), zone_words,
+            m_columns[0]);
+
+        if (zones == nullptr)
+        {
+            return false;
+        }
+
+        m_zones.assign(zones, zones + zone_words);
+        return true;
+    }
+
+    /// @return The words read from the source, or nullptr if the read
+    ///         failed which makes the reader invalid
+    const uint64_t* read(uint64_t offset, uint64_t words,
+                         std::vector<uint64_t>& buffer)
+    {
+        const uint64_t* data = m_source.read(offset, words, buffer);
+
+        if (data == nullptr)
+        {
+            m_valid = false;
+            return nullptr;
+        }
+
+        m_bytes_read += words * sizeof(uint64_t);
+        return data;
+    }
+
+    /// @return The column of the field in the block
+    const uint64_t* read_column(uint64_t block, uint32_t field)
+    {
+        uint64_t offset = format::block_offset(m_block_records, block) +
+                          format::column_offset(m_block_records, field);
+
+        return read(offset, format::column_words(m_block_records, field),
+                    m_columns[field]);
+    }
+
+private:
+
+    /// The source of the file
+    Source m_source;
+
+    /// The buffers of the columns of a block, if the source needs them
+    std::vector<std::vector<uint64_t>> m_columns;
+
+    /// The zone maps of all blocks
+    std::vector<uint64_t> m_zones;
+
+    /// The number of records
+    uint64_t m_records = 0;
+
+    /// The number of records in a block
+    uint64_t m_block_records = 0;
+
+    /// The number of blocks
+    uint64_t m_blocks = 0;
+
+    /// The number of bytes read through the source
+    uint64_t m_bytes_read = 0;
+
+    /// The number of bytes of blocks skipped
+    uint64_t m_bytes_skipped = 0;
+
+    /// True if the file is valid
+    bool m_valid = false;
+};
+}
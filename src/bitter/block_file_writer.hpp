@@ -0,0 +1,290 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/block_file_format.hpp"
+#include "detail/packed_bits.hpp"
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Sink of a block_file_writer appending the words of the file to
+///        a vector in memory
+class vector_sink
+{
+public:
+
+    /// @brief Sink constructor
+    /// @param words is the vector to append to, it must stay valid for the
+    ///        lifetime of the sink
+    explicit vector_sink(std::vector<uint64_t>& words) :
+        m_words(&words)
+    {
+    }
+
+    /// @brief Appends words to the vector
+    /// @return Always true
+    bool write(const uint64_t* words, uint64_t count)
+    {
+        m_words->insert(m_words->end(), words, words + count);
+        return true;
+    }
+
+private:
+
+    /// The vector to append to
+    std::vector<uint64_t>* m_words;
+};
+
+/// @brief Sink of a block_file_writer writing the words of the file with a
+///        function, e.g. wrapping fwrite:
+///
+///     auto sink = bitter::make_callback_sink(
+///         [file](const void* data, uint64_t size)
+///         {
+///             return fwrite(data, 1, size, file) == size;
+///         });
+///
+template<class Function>
+class callback_sink
+{
+public:
+
+    /// @brief Sink constructor
+    /// @param function is invoked as function(data, size) to append size
+    ///        bytes to the file and must return true if all were written
+    explicit callback_sink(Function function) :
+        m_function(std::move(function))
+    {
+    }
+
+    /// @brief Appends words to the file
+    /// @return True if the words were written
+    bool write(const uint64_t* words, uint64_t count)
+    {
+        return m_function(static_cast<const void*>(words),
+                          count * sizeof(uint64_t));
+    }
+
+private:
+
+    /// The function writing the file
+    Function m_function;
+};
+
+/// @return A callback_sink using function
+template<class Function>
+callback_sink<Function> make_callback_sink(Function function)
+{
+    return callback_sink<Function>(std::move(function));
+}
+
+/// @brief Writer of records of a layout in the block file format, where
+///        the records are stored column by column in blocks of a fixed
+///        number of records with the minimum and maximum value of every
+///        field of every block (zone maps). A block_file_reader can then
+///        skip blocks which cannot match a field range:
+///
+///     bitter::block_file_writer<record, decltype(sink)> writer(sink, 4096);
+///     writer.write(records, count);
+///     writer.finish();
+///
+/// The zone maps are computed while writing. A block is packed into its
+/// columns and written to the sink once it is full, so the writer only
+/// holds the current block and the zone maps in memory, which are written
+/// after the last block by finish().
+template<class Layout, class Sink = vector_sink>
+class block_file_writer
+{
+public:
+
+    /// The integer type holding a record
+    using value_type = typename Layout::value_type;
+
+    static_assert(sizeof(value_type) <= sizeof(uint64_t),
+                  "The block file format supports fields of up to 64 bits");
+
+    /// @brief Writer constructor
+    /// @param sink is the sink to write the file to
+    /// @param block_records is the number of records in a block
+    explicit block_file_writer(Sink sink, uint64_t block_records = 4096) :
+        m_sink(std::move(sink)),
+        m_block_records(block_records),
+        m_columns(format::block_words(block_records))
+    {
+        assert(block_records > 0);
+        m_block.reserve(block_records);
+    }
+
+    /// @brief Writes a record
+    /// @return False if writing a full block to the sink failed
+    bool write(value_type value)
+    {
+        assert(!m_finished && "The file is finished");
+
+        m_block.push_back(value);
+        ++m_records;
+
+        if (m_block.size() == m_block_records)
+        {
+            flush();
+        }
+
+        return m_good;
+    }
+
+    /// @brief Writes an array of records
+    /// @return False if writing to the sink failed
+    bool write(const value_type* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count && m_good; ++i)
+        {
+            write(values[i]);
+        }
+
+        return m_good;
+    }
+
+    /// @return The number of records written
+    uint64_t records() const
+    {
+        return m_records;
+    }
+
+    /// @return The number of blocks written to the sink
+    uint64_t blocks() const
+    {
+        return m_blocks;
+    }
+
+    /// @brief Writes the last block, the zone maps and the trailer. No
+    ///        records can be written afterwards.
+    /// @return True if the whole file was written to the sink
+    bool finish()
+    {
+        assert(!m_finished && "The file is finished");
+
+        if (!m_block.empty() || m_blocks == 0)
+        {
+            // Even an empty file starts with the header
+            flush();
+        }
+
+        uint64_t trailer[format::trailer_words] =
+        {
+            m_records, m_blocks, format::magic
+        };
+
+        write_words(m_zones.data(), m_zones.size());
+        write_words(trailer, format::trailer_words);
+
+        m_finished = true;
+        return m_good;
+    }
+
+private:
+
+    /// The layout of the file
+    using format = detail::block_file_format<Layout>;
+
+    /// Writes the header before the first block, then packs the current
+    /// block into columns, computes its zone maps and writes it
+    void flush()
+    {
+        if (!m_header)
+        {
+            uint64_t header[format::header_words] =
+            {
+                format::magic, m_block_records, Layout::fields, Layout::bits
+            };
+
+            write_words(header, format::header_words);
+            m_header = true;
+        }
+
+        if (m_block.empty())
+        {
+            return;
+        }
+
+        std::fill(m_columns.begin(), m_columns.end(), 0);
+
+        for (uint32_t field = 0; field < Layout::fields; ++field)
+        {
+            uint64_t* column = m_columns.data() +
+                               format::column_offset(m_block_records, field);
+
+            uint32_t size = Layout::table::sizes[field];
+            uint64_t min = ~uint64_t{0};
+            uint64_t max = 0;
+
+            for (uint64_t i = 0; i < m_block.size(); ++i)
+            {
+                uint64_t value = Layout::table::get(m_block[i], field);
+
+                min = std::min(min, value);
+                max = std::max(max, value);
+
+                write_bits(column, i * size, size, value);
+            }
+
+            m_zones.push_back(min);
+            m_zones.push_back(max);
+        }
+
+        write_words(m_columns.data(), m_columns.size());
+
+        ++m_blocks;
+        m_block.clear();
+    }
+
+    /// Writes words to the sink unless a previous write failed
+    void write_words(const uint64_t* words, uint64_t count)
+    {
+        m_good = m_good && (count == 0 || m_sink.write(words, count));
+    }
+
+private:
+
+    /// The sink of the file
+    Sink m_sink;
+
+    /// The number of records in a block
+    uint64_t m_block_records;
+
+    /// The number of records written
+    uint64_t m_records = 0;
+
+    /// The number of blocks written
+    uint64_t m_blocks = 0;
+
+    /// The records of the current block
+    std::vector<value_type> m_block;
+
+    /// The columns of the current block
+    std::vector<uint64_t> m_columns;
+
+    /// The zone maps of the written blocks
+    std::vector<uint64_t> m_zones;
+
+    /// True if the header was written
+    bool m_header = false;
+
+    /// False once writing to the sink failed
+    bool m_good = true;
+
+    /// True once the file is finished
+    bool m_finished = false;
+};
+}
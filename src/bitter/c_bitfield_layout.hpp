@@ -0,0 +1,194 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/any_field.hpp"
+#include "detail/bit_cast.hpp"
+
+#include "layout.hpp"
+#include "lsb0.hpp"
+#include "msb0.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace bitter
+{
+/// The bit numbering of C bit fields with the GCC and Clang ABIs: the
+/// first field is placed in the least significant bits on little endian
+/// targets (x86-64, AArch64) and in the most significant bits on big
+/// endian targets.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+using c_bitfield_numbering = msb0;
+#else
+using c_bitfield_numbering = lsb0;
+#endif
+
+namespace detail
+{
+/// @return True if no field crosses a boundary of the Unit bits storage
+///         units, which the C ABI never lets a bit field do
+template<uint32_t Unit, uint32_t... Sizes>
+constexpr bool is_within_units()
+{
+    const uint32_t sizes[] = { Sizes... };
+    uint32_t position = 0;
+
+    for (uint32_t size : sizes)
+    {
+        if (size == 0 || position / Unit != (position + size - 1) / Unit)
+        {
+            return false;
+        }
+        position += size;
+    }
+    return true;
+}
+}
+
+/// @brief Layout placing the fields like the compiler places the members
+///        of a C struct of bit fields declared with the type Unit, such
+///        that values can be copied to and from the struct without any
+///        conversion:
+///
+///     struct c_header // From a C header
+///     {
+///         uint16_t version : 4;
+///         uint16_t type : 10;
+///         uint16_t padding0 : 2; // id does not fit in the first unit
+///         uint16_t id : 12;
+///         uint16_t padding1 : 4;
+///     };
+///
+///     using header = bitter::c_bitfield_layout<uint32_t, uint16_t,
+///         4, 10, 2, 12, 4>;
+///
+///     static_assert(header::matches<c_header>(), "");
+///     uint32_t value = header::from_struct(h);
+///
+/// The fields of the layout must fill the whole DataType, so bits the
+/// compiler skips (a field not fitting in the rest of its storage unit,
+/// tail padding) must be padding fields of the layout, and matches(...)
+/// requires them to be named members of the struct too. Fields crossing a
+/// Unit boundary are rejected at compile time.
+template<class DataType, class Unit, uint32_t... Sizes>
+struct c_bitfield_layout :
+    public layout<DataType, c_bitfield_numbering, Sizes...>
+{
+    /// The layout with the fields placed like C bit fields
+    using layout_type = layout<DataType, c_bitfield_numbering, Sizes...>;
+
+    /// The integer type holding a value of the layout
+    using value_type = typename layout_type::value_type;
+
+    static_assert(std::is_integral<Unit>::value,
+                  "The unit must be an integer type");
+
+    static_assert(sizeof(value_type) * 8 == layout_type::bits,
+                  "The data type must be a native integer type");
+
+    static_assert(detail::is_within_units<sizeof(Unit) * 8, Sizes...>(),
+                  "A field crosses a storage unit, add a padding field");
+
+    /// @return The value of the layout stored in a struct
+    template<class Struct>
+    static constexpr value_type from_struct(const Struct& value)
+    {
+        return detail::bit_cast<value_type>(value);
+    }
+
+    /// @return The struct storing a value of the layout
+    template<class Struct>
+    static constexpr Struct to_struct(value_type value)
+    {
+        return detail::bit_cast<Struct>(value);
+    }
+
+    /// @brief Copies an array of structs to an array of values, which is
+    ///        a single memcpy as the bits are placed the same way
+    template<class Struct>
+    static void from_structs(const Struct* structs, uint64_t count,
+                             value_type* values)
+    {
+        static_assert(sizeof(Struct) == sizeof(value_type),
+                      "The sizes must be equal");
+        static_assert(std::is_trivially_copyable<Struct>::value,
+                      "The struct must be trivially copyable");
+
+        assert((structs != nullptr && values != nullptr) || count == 0);
+
+        if (count > 0)
+        {
+            std::memcpy(values, structs, count * sizeof(value_type));
+        }
+    }
+
+    /// @brief Copies an array of values to an array of structs
+    template<class Struct>
+    static void to_structs(const value_type* values, uint64_t count,
+                           Struct* structs)
+    {
+        static_assert(sizeof(Struct) == sizeof(value_type),
+                      "The sizes must be equal");
+        static_assert(std::is_trivially_copyable<Struct>::value,
+                      "The struct must be trivially copyable");
+
+        assert((values != nullptr && structs != nullptr) || count == 0);
+
+        if (count > 0)
+        {
+            std::memcpy(structs, values, count * sizeof(value_type));
+        }
+    }
+
+    /// @brief Checks that the compiler places each member of Struct where
+    ///        the layout places the field with the same index, by setting
+    ///        one member at a time to all ones. Usable in a static_assert
+    ///        if BITTER_HAS_CONSTEXPR_BIT_CAST is defined and otherwise
+    ///        at runtime. In a static_assert bits of the struct not
+    ///        covered by a member fail to compile, as they are
+    ///        uninitialized.
+    /// @return True if the struct and the layout match
+    template<class Struct>
+    static constexpr bool matches()
+    {
+        static_assert(sizeof(Struct) == sizeof(value_type),
+                      "The sizes must be equal");
+        static_assert(detail::is_initializable<Struct,
+                      std::make_index_sequence<layout_type::fields>>::value,
+                      "The struct must have a member for every field");
+
+        for (uint32_t i = 0; i < layout_type::fields; ++i)
+        {
+            value_type mask = value_type(
+                layout_type::table::masks[i] << layout_type::table::offsets[i]);
+
+            if (from_struct(only_field<Struct>(i,
+                std::make_integer_sequence<uint32_t, layout_type::fields>()))
+                != mask)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    /// @return The struct with the member at index set to all ones
+    template<class Struct, uint32_t... Indices>
+    static constexpr Struct only_field(
+        uint32_t index, std::integer_sequence<uint32_t, Indices...>)
+    {
+        return Struct{ detail::any_field<value_type>{
+                Indices == index ? layout_type::table::masks[Indices] :
+                value_type(0) }...
+        };
+    }
+};
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/extract_bits.hpp"
+#include "detail/lane_masks.hpp"
+#include "detail/reverse_bits.hpp"
+
+#include "layout.hpp"
+#include "msb0.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+namespace bitter
+{
+namespace detail
+{
+/// Finds the changed fields of a layout of up to 64 bits with lane masks
+template<class Layout>
+uint64_t changed_fields(typename Layout::value_type previous,
+                        typename Layout::value_type current, std::true_type)
+{
+    const uint64_t low = lane_masks<Layout>::low();
+    const uint64_t high = lane_masks<Layout>::top();
+
+    uint64_t x = uint64_t(previous ^ current);
+    uint64_t top = (((x & low) + low) | x) & high;
+
+    uint64_t changed = extract_bits(top, high);
+
+    // In MSB 0 mode field 0 holds the most significant bits
+    if (std::is_same<typename Layout::bit_numbering, msb0>::value)
+    {
+        changed = reverse_bits(changed, Layout::fields);
+    }
+
+    return changed;
+}
+
+/// Finds the changed fields of a wider layout one field at a time
+template<class Layout>
+uint64_t changed_fields(typename Layout::value_type previous,
+                        typename Layout::value_type current, std::false_type)
+{
+    typename Layout::value_type x = previous ^ current;
+    uint64_t changed = 0;
+
+    for (uint32_t i = 0; i < Layout::fields; ++i)
+    {
+        if (Layout::table::get(x, i) != 0)
+        {
+            changed |= uint64_t{1} << i;
+        }
+    }
+
+    return changed;
+}
+}
+
+/// @brief Finds the fields which differ between two values of a layout,
+///        e.g. to only send the changed fields of a state word:
+///
+///     using state = bitter::lsb0_layout<uint32_t, 1, 7, 8, 16>;
+///     uint64_t changed = bitter::changed_fields<state>(previous, current);
+///
+///     if (changed & (1U << 2)) { ... field 2 changed ... }
+///
+/// All fields are checked at once: the differing bits of the fields (the
+/// XOR of the values) are OR reduced into the most significant bit of each
+/// field by adding the low bits of the fields, which carries into the top
+/// bit of a field only if one of its low bits is set:
+///
+///     ((x & low) + low) | x
+///
+/// The top bits are then gathered into the result (with pext if BMI2 is
+/// available). Layouts wider than 64 bits (e.g. u128) are checked one
+/// field at a time.
+/// @return A mask with bit i set if field i differs
+template<class Layout>
+uint64_t changed_fields(typename Layout::value_type previous,
+                        typename Layout::value_type current)
+{
+    static_assert(Layout::fields <= 64,
+                  "The mask of changed fields holds up to 64 fields");
+
+    return detail::changed_fields<Layout>(
+        previous, current,
+        std::integral_constant<bool, (Layout::bits <= 64)>());
+}
+
+/// @brief Finds the changed fields of two arrays of values
+/// @param previous is the previous values
+/// @param current is the current values
+/// @param count is the number of values in each array
+/// @param changed is the count masks to write, see
+///        changed_fields(previous, current)
+template<class Layout>
+void changed_fields(const typename Layout::value_type* previous,
+                    const typename Layout::value_type* current,
+                    uint64_t count, uint64_t* changed)
+{
+    assert((previous != nullptr && current != nullptr && changed != nullptr)
+           || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        changed[i] = changed_fields<Layout>(previous[i], current[i]);
+    }
+}
+}
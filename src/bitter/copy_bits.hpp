@@ -0,0 +1,219 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/load_big_endian.hpp"
+#include "detail/load_little_endian.hpp"
+#include "detail/store_big_endian.hpp"
+#include "detail/store_little_endian.hpp"
+
+#include "lsb0.hpp"
+#include "msb0.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Reads and writes bits at any bit position of a byte buffer in
+///        the order given by the bit numbering
+template<class BitNumbering>
+struct bit_copy;
+
+/// Bit 0 is the least significant bit of the first byte, a value read
+/// has the first bit as its least significant bit
+template<>
+struct bit_copy<lsb0>
+{
+    /// @return The bits starting at position bit, at most 8
+    static uint32_t read_byte(const uint8_t* data, uint64_t bit, uint32_t bits)
+    {
+        uint64_t byte = bit / 8;
+        uint32_t shift = bit % 8;
+        uint32_t value = data[byte] >> shift;
+
+        if (shift + bits > 8)
+        {
+            value |= uint32_t(data[byte + 1]) << (8 - shift);
+        }
+
+        return value & ((1U << bits) - 1);
+    }
+
+    /// @brief Writes bits at position bit, all within the same byte
+    static void write_byte(uint8_t* data, uint64_t bit, uint32_t bits,
+                           uint32_t value)
+    {
+        uint32_t mask = ((1U << bits) - 1) << (bit % 8);
+        uint8_t& byte = data[bit / 8];
+        byte = static_cast<uint8_t>((byte & ~mask) | ((value << (bit % 8)) & mask));
+    }
+
+    /// @return The 64 bits starting at position bit
+    static uint64_t read_word(const uint8_t* data, uint64_t bit)
+    {
+        uint64_t byte = bit / 8;
+        uint32_t shift = bit % 8;
+        uint64_t value = load_little_endian<u64>(data + byte) >> shift;
+
+        if (shift != 0)
+        {
+            value |= uint64_t(data[byte + 8]) << (64 - shift);
+        }
+
+        return value;
+    }
+
+    /// @brief Writes 64 bits starting at a whole byte
+    static void write_word(uint8_t* data, uint64_t value)
+    {
+        store_little_endian<u64>(value, data);
+    }
+};
+
+/// Bit 0 is the most significant bit of the first byte, a value read has
+/// the first bit as its most significant bit
+template<>
+struct bit_copy<msb0>
+{
+    /// @return The bits starting at position bit, at most 8
+    static uint32_t read_byte(const uint8_t* data, uint64_t bit, uint32_t bits)
+    {
+        uint64_t byte = bit / 8;
+        uint32_t shift = bit % 8;
+        uint32_t value = uint32_t(data[byte]) << 8;
+
+        if (shift + bits > 8)
+        {
+            value |= data[byte + 1];
+        }
+
+        return (value >> (16 - shift - bits)) & ((1U << bits) - 1);
+    }
+
+    /// @brief Writes bits at position bit, all within the same byte
+    static void write_byte(uint8_t* data, uint64_t bit, uint32_t bits,
+                           uint32_t value)
+    {
+        uint32_t shift = 8 - bit % 8 - bits;
+        uint32_t mask = ((1U << bits) - 1) << shift;
+        uint8_t& byte = data[bit / 8];
+        byte = static_cast<uint8_t>((byte & ~mask) | ((value << shift) & mask));
+    }
+
+    /// @return The 64 bits starting at position bit
+    static uint64_t read_word(const uint8_t* data, uint64_t bit)
+    {
+        uint64_t byte = bit / 8;
+        uint32_t shift = bit % 8;
+        uint64_t value = load_big_endian<u64>(data + byte) << shift;
+
+        if (shift != 0)
+        {
+            value |= uint64_t(data[byte + 8]) >> (8 - shift);
+        }
+
+        return value;
+    }
+
+    /// @brief Writes 64 bits starting at a whole byte
+    static void write_word(uint8_t* data, uint64_t value)
+    {
+        store_big_endian<u64>(value, data);
+    }
+};
+}
+
+/// @brief Copies a range of bits between two byte buffers at any bit
+///        offsets, e.g. to append a 13 bit field sequence after a 3 bit
+///        prefix:
+///
+///     bitter::copy_bits<bitter::msb0>(frame, 3, fields, 0, 13);
+///
+/// In msb0 mode bit 0 is the most significant bit of the first byte, in
+/// lsb0 mode the least significant bit. The bits of the destination
+/// outside the range are kept.
+///
+/// The copy aligns the destination to a byte, then copies 64 bits at a
+/// time with a funnel shift of two source words (or with memcpy if the
+/// source is aligned as well) and copies the remaining bits bytewise.
+/// Bytes outside the source and destination ranges are never accessed.
+/// @param destination is the buffer to write to, it must not overlap the
+///        source range
+/// @param destination_offset is the position of the first bit to write
+/// @param source is the buffer to read from
+/// @param source_offset is the position of the first bit to read
+/// @param bits is the number of bits to copy
+template<class BitNumbering>
+void copy_bits(uint8_t* destination, uint64_t destination_offset,
+               const uint8_t* source, uint64_t source_offset, uint64_t bits)
+{
+    using copy = detail::bit_copy<BitNumbering>;
+
+    assert((destination != nullptr && source != nullptr) || bits == 0);
+
+    // Copy up to the first whole byte of the destination
+    uint32_t head = static_cast<uint32_t>(
+        std::min<uint64_t>((8 - destination_offset % 8) % 8, bits));
+
+    if (head > 0)
+    {
+        copy::write_byte(destination, destination_offset, head,
+                         copy::read_byte(source, source_offset, head));
+
+        destination_offset += head;
+        source_offset += head;
+        bits -= head;
+    }
+
+    if (source_offset % 8 == 0)
+    {
+        uint64_t bytes = bits / 8;
+
+        if (bytes > 0)
+        {
+            std::memcpy(destination + destination_offset / 8,
+                        source + source_offset / 8, bytes);
+        }
+
+        destination_offset += bytes * 8;
+        source_offset += bytes * 8;
+        bits -= bytes * 8;
+    }
+    else
+    {
+        for (; bits >= 64; bits -= 64)
+        {
+            copy::write_word(destination + destination_offset / 8,
+                             copy::read_word(source, source_offset));
+
+            destination_offset += 64;
+            source_offset += 64;
+        }
+    }
+
+    for (; bits >= 8; bits -= 8)
+    {
+        destination[destination_offset / 8] =
+            static_cast<uint8_t>(copy::read_byte(source, source_offset, 8));
+
+        destination_offset += 8;
+        source_offset += 8;
+    }
+
+    if (bits > 0)
+    {
+        copy::write_byte(destination, destination_offset,
+                         static_cast<uint32_t>(bits),
+                         copy::read_byte(source, source_offset,
+                                         static_cast<uint32_t>(bits)));
+    }
+}
+}
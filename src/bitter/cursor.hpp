@@ -0,0 +1,176 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/load_layout.hpp"
+#include "detail/prefetch.hpp"
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Cursor reading a chain of records (e.g. protocol headers) from
+///        a byte buffer in one forward pass without copying it. Every
+///        step reads one layout or skips a number of bytes given by a
+///        length field, and is checked against the end of the buffer
+///        once:
+///
+///     // Version, IHL, type of service and total length
+///     using ipv4 = bitter::msb0_layout<uint32_t, 4, 4, 8, 16>;
+///     // Source port, destination port, length and checksum
+///     using udp = bitter::msb0_layout<uint64_t, 16, 16, 16, 16>;
+///
+///     bitter::cursor cursor(packet, size);
+///     ipv4::value_type ip;
+///     udp::value_type header;
+///
+///     // Skip the rest of the IPv4 header (including options) by its IHL
+///     bool ok = cursor.peek<ipv4>(ip) &&
+///               cursor.skip(ipv4::get<1>(ip) * 4) &&
+///               cursor.read<udp>(header);
+///
+/// The bytes of a layout are loaded in big endian (network) byte order if
+/// it uses msb0 and in little endian byte order if it uses lsb0, matching
+/// the order of the bits.
+class cursor
+{
+public:
+
+    /// @brief Cursor constructor
+    /// @param data is the buffer to read from
+    /// @param size is the size of the buffer in bytes
+    cursor(const uint8_t* data, uint64_t size) :
+        m_begin(data),
+        m_data(data),
+        m_end(data + size)
+    {
+        assert(data != nullptr || size == 0);
+    }
+
+    /// @return The current position in the buffer
+    const uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    /// @return The number of bytes read or skipped
+    uint64_t position() const
+    {
+        return static_cast<uint64_t>(m_data - m_begin);
+    }
+
+    /// @return The number of bytes left in the buffer
+    uint64_t remaining() const
+    {
+        return static_cast<uint64_t>(m_end - m_data);
+    }
+
+    /// @return True if the cursor is at the end of the buffer
+    bool empty() const
+    {
+        return m_data == m_end;
+    }
+
+    /// @return The size in bytes of a value of Layout
+    template<class Layout>
+    static constexpr uint64_t size()
+    {
+        return Layout::bitter_type::size;
+    }
+
+    /// @brief Reads a value of Layout without advancing the cursor
+    /// @param value is set to the value if it is within the buffer
+    /// @return True if the value was read, false if the buffer is too
+    ///         short (value is left unchanged)
+    template<class Layout>
+    bool peek(typename Layout::value_type& value) const
+    {
+        if (remaining() < size<Layout>())
+        {
+            return false;
+        }
+
+        value = load_layout<Layout>(m_data);
+        return true;
+    }
+
+    /// @brief Reads a value of Layout and advances past it
+    /// @param value is set to the value if it is within the buffer
+    /// @return True if the value was read, false if the buffer is too
+    ///         short (the cursor and value are left unchanged)
+    template<class Layout>
+    bool read(typename Layout::value_type& value)
+    {
+        if (!peek<Layout>(value))
+        {
+            return false;
+        }
+
+        m_data += size<Layout>();
+        return true;
+    }
+
+    /// @brief Advances the cursor, e.g. past the options of a header by
+    ///        its length field
+    /// @param bytes is the number of bytes to skip
+    /// @return True if the bytes were skipped, false if the buffer is too
+    ///         short (the cursor is left unchanged)
+    bool skip(uint64_t bytes)
+    {
+        if (remaining() < bytes)
+        {
+            return false;
+        }
+
+        m_data += bytes;
+        return true;
+    }
+
+    /// @brief Splits off the next bytes as a separate cursor, e.g. the
+    ///        payload of a record with a length field, and advances past
+    ///        them
+    /// @param bytes is the number of bytes to split off
+    /// @param record is set to a cursor over the bytes
+    /// @return True if the bytes were split off, false if the buffer is
+    ///         too short (the cursor and record are left unchanged)
+    bool split(uint64_t bytes, cursor& record)
+    {
+        if (remaining() < bytes)
+        {
+            return false;
+        }
+
+        record = cursor(m_data, bytes);
+        m_data += bytes;
+        return true;
+    }
+
+    /// @brief Hints the processor to load the bytes at an offset from the
+    ///        current position, e.g. the next record of a batch while the
+    ///        current one is parsed. Offsets past the end are ignored.
+    /// @param offset is the offset in bytes from the current position
+    void prefetch(uint64_t offset = 0) const
+    {
+        if (offset < remaining())
+        {
+            bitter::prefetch(m_data + offset);
+        }
+    }
+
+private:
+
+    /// The start of the buffer
+    const uint8_t* m_begin;
+
+    /// The current position
+    const uint8_t* m_data;
+
+    /// The end of the buffer
+    const uint8_t* m_end;
+};
+}
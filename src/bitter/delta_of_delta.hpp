@@ -0,0 +1,180 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/sign_extend.hpp"
+
+#include "bit_stream_reader.hpp"
+#include "bit_stream_writer.hpp"
+#include "exp_golomb.hpp"
+#include "layout.hpp"
+#include "zigzag.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Encoder of a series of values of a layout field by field. Every
+///        field is stored as the change of its delta from the previous
+///        value (the delta of delta), so fields that are constant or
+///        change at a constant rate (counters, timestamps) take a single
+///        bit per value. The delta of delta is computed modulo the size of
+///        the field and written as a zigzag mapped Exp-Golomb code.
+///
+/// Fields which change randomly are better stored by the gorilla_encoder
+/// or kept in a separate layout.
+template<class Layout, class BitNumbering>
+class delta_of_delta_encoder
+{
+public:
+
+    /// The integer type holding a value
+    using value_type = typename Layout::value_type;
+
+    static_assert(sizeof(value_type) <= sizeof(uint64_t),
+                  "Delta of delta coding supports values of up to 64 bits");
+    static_assert(Layout::table::max_size() < 64,
+                  "Delta of delta coding supports fields of up to 63 bits");
+
+    /// @brief Encoder constructor
+    /// @param writer is the stream to write to
+    explicit delta_of_delta_encoder(bit_stream_writer<BitNumbering>& writer) :
+        m_writer(writer)
+    {
+        for (uint32_t field = 0; field < Layout::fields; ++field)
+        {
+            m_previous[field] = 0;
+            m_delta[field] = 0;
+        }
+    }
+
+    /// @brief Writes the next value of the series
+    void encode(value_type value)
+    {
+        for (uint32_t field = 0; field < Layout::fields; ++field)
+        {
+            uint32_t size = Layout::table::sizes[field];
+            uint64_t mask = (uint64_t{1} << size) - 1;
+            uint64_t current = Layout::table::get(value, field);
+
+            uint64_t delta = (current - m_previous[field]) & mask;
+            uint64_t change = (delta - m_delta[field]) & mask;
+
+            exp_golomb_encode(m_writer, zigzag_encode(
+                                  detail::sign_extend(change, size)));
+
+            m_previous[field] = current;
+            m_delta[field] = delta;
+        }
+    }
+
+    /// @brief Writes an array of values of the series
+    void encode(const value_type* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            encode(values[i]);
+        }
+    }
+
+private:
+
+    /// The stream to write to
+    bit_stream_writer<BitNumbering>& m_writer;
+
+    /// The fields of the previous value
+    uint64_t m_previous[Layout::fields];
+
+    /// The deltas of the fields of the previous value
+    uint64_t m_delta[Layout::fields];
+};
+
+/// @brief Decoder of a series of values of a layout written by a
+///        delta_of_delta_encoder
+template<class Layout, class BitNumbering>
+class delta_of_delta_decoder
+{
+public:
+
+    /// The integer type holding a value
+    using value_type = typename Layout::value_type;
+
+    static_assert(sizeof(value_type) <= sizeof(uint64_t),
+                  "Delta of delta coding supports values of up to 64 bits");
+    static_assert(Layout::table::max_size() < 64,
+                  "Delta of delta coding supports fields of up to 63 bits");
+
+    /// @brief Decoder constructor
+    /// @param reader is the stream to read from
+    explicit delta_of_delta_decoder(bit_stream_reader<BitNumbering>& reader) :
+        m_reader(reader)
+    {
+        for (uint32_t field = 0; field < Layout::fields; ++field)
+        {
+            m_previous[field] = 0;
+            m_delta[field] = 0;
+        }
+    }
+
+    /// @return The next value of the series. If the stream ends or holds
+    ///         an invalid code the reader becomes invalid, see
+    ///         bit_stream_reader::is_valid().
+    value_type decode()
+    {
+        value_type value = 0;
+
+        for (uint32_t field = 0; field < Layout::fields; ++field)
+        {
+            uint32_t size = Layout::table::sizes[field];
+            uint64_t mask = (uint64_t{1} << size) - 1;
+
+            uint64_t change = static_cast<uint64_t>(
+                zigzag_decode(exp_golomb_decode(m_reader)));
+
+            m_delta[field] = (m_delta[field] + change) & mask;
+            m_previous[field] = (m_previous[field] + m_delta[field]) & mask;
+
+            value = Layout::table::set(
+                value, field, static_cast<value_type>(m_previous[field]));
+        }
+
+        return value;
+    }
+
+    /// @brief Reads an array of values of the series
+    /// @return The number of values decoded, less than count if the stream
+    ///         ended or held an invalid code
+    uint64_t decode(value_type* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            values[i] = decode();
+
+            if (!m_reader.is_valid())
+            {
+                return i;
+            }
+        }
+
+        return count;
+    }
+
+private:
+
+    /// The stream to read from
+    bit_stream_reader<BitNumbering>& m_reader;
+
+    /// The fields of the previous value
+    uint64_t m_previous[Layout::fields];
+
+    /// The deltas of the fields of the previous value
+    uint64_t m_delta[Layout::fields];
+};
+}
@@ -0,0 +1,40 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace bitter
+{
+namespace detail
+{
+/// A field value converting to the type of whatever member it initializes,
+/// used to aggregate initialize a struct from the fields of a layout
+template<class Type>
+struct any_field
+{
+    template<class Member>
+    constexpr operator Member() const
+    {
+        return static_cast<Member>(m_value);
+    }
+
+    Type m_value;
+};
+
+/// Checks whether Struct can be aggregate initialized from Count values
+template<class Struct, class Indices, class = void>
+struct is_initializable : std::false_type
+{ };
+
+template<class Struct, std::size_t... Indices>
+struct is_initializable<Struct, std::index_sequence<Indices...>,
+    decltype(void(Struct{ (void(Indices), any_field<uint64_t>{})... }))> :
+    std::true_type
+{ };
+}
+}
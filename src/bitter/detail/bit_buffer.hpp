@@ -0,0 +1,232 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "count_leading_zeros.hpp"
+#include "count_trailing_zeros.hpp"
+#include "load_big_endian.hpp"
+#include "load_little_endian.hpp"
+
+#include "../lsb0.hpp"
+#include "../msb0.hpp"
+#include "../types.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief The operations on a 64 bit buffer holding the next bits of a
+///        bit stream. Specialized for the bit numbering which decides in
+///        which order the bits of each byte enter the stream.
+template<class BitNumbering>
+struct bit_buffer;
+
+/// In MSB 0 mode the most significant bit of each byte is the first bit
+/// in the stream (as used by e.g. H.264 and JPEG). The buffer is kept
+/// left aligned such that the next bit is the most significant bit of the
+/// buffer.
+template<>
+struct bit_buffer<msb0>
+{
+    /// @return The 64 bits starting at data in stream order
+    static uint64_t load(const uint8_t* data)
+    {
+        return load_big_endian<u64>(data);
+    }
+
+    /// @return The buffer with the bits of value appended after the count
+    ///         bits already in the buffer
+    static uint64_t append(uint64_t buffer, uint32_t count, uint64_t value)
+    {
+        assert(count < 64);
+        return buffer | (value >> count);
+    }
+
+    /// @return The single byte appended after the count bits already in
+    ///         the buffer
+    static uint64_t append_byte(uint64_t buffer, uint32_t count, uint8_t byte)
+    {
+        assert(count <= 56);
+        return buffer | (static_cast<uint64_t>(byte) << (56 - count));
+    }
+
+    /// @return The next bits of the buffer as an integer, the first bit
+    ///         in the stream being the most significant bit
+    static uint64_t peek(uint64_t buffer, uint32_t bits)
+    {
+        assert(bits > 0 && bits < 64);
+        return buffer >> (64 - bits);
+    }
+
+    /// @return The buffer with the next bits removed
+    static uint64_t consume(uint64_t buffer, uint32_t bits)
+    {
+        assert(bits < 64);
+        return buffer << bits;
+    }
+
+    /// @return The number of zero bits before the next one bit
+    static uint32_t zeros(uint64_t buffer)
+    {
+        return buffer ? count_leading_zeros(buffer) : 64U;
+    }
+
+    /// @return The value of two consecutive reads combined
+    static uint64_t combine(uint64_t first, uint32_t first_bits,
+                            uint64_t second, uint32_t second_bits)
+    {
+        (void) first_bits;
+        return (first << second_bits) | second;
+    }
+
+    /// Splits value into the parts written first and second
+    static void split(uint64_t value, uint32_t first_bits,
+                      uint32_t second_bits, uint64_t& first, uint64_t& second)
+    {
+        (void) first_bits;
+        first = value >> second_bits;
+        second = value & ((uint64_t{1} << second_bits) - 1);
+    }
+
+    /// @return The accumulator of a writer with the bits of value added.
+    ///         The accumulator is right aligned and the first bit in the
+    ///         stream is the most significant of the count bits.
+    static uint64_t push(uint64_t accumulator, uint32_t count,
+                         uint64_t value, uint32_t bits)
+    {
+        assert(count + bits <= 64 && bits < 64);
+        (void) count;
+        return (accumulator << bits) | value;
+    }
+
+    /// @return The next complete byte of the accumulator
+    static uint8_t front_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count >= 8);
+        return static_cast<uint8_t>(accumulator >> (count - 8));
+    }
+
+    /// @return The accumulator with the front byte removed
+    static uint64_t pop_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count >= 8);
+        return accumulator & ((uint64_t{1} << (count - 8)) - 1);
+    }
+
+    /// @return The last partial byte padded with zero bits
+    static uint8_t pad_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count < 8);
+        return static_cast<uint8_t>(accumulator << (8 - count));
+    }
+};
+
+/// In LSB 0 mode the least significant bit of each byte is the first bit
+/// in the stream (as used by e.g. DEFLATE). The buffer is kept right
+/// aligned such that the next bit is the least significant bit of the
+/// buffer.
+template<>
+struct bit_buffer<lsb0>
+{
+    /// @return The 64 bits starting at data in stream order
+    static uint64_t load(const uint8_t* data)
+    {
+        return load_little_endian<u64>(data);
+    }
+
+    /// @return The buffer with the bits of value appended after the count
+    ///         bits already in the buffer
+    static uint64_t append(uint64_t buffer, uint32_t count, uint64_t value)
+    {
+        assert(count < 64);
+        return buffer | (value << count);
+    }
+
+    /// @return The single byte appended after the count bits already in
+    ///         the buffer
+    static uint64_t append_byte(uint64_t buffer, uint32_t count, uint8_t byte)
+    {
+        assert(count <= 56);
+        return buffer | (static_cast<uint64_t>(byte) << count);
+    }
+
+    /// @return The next bits of the buffer as an integer, the first bit
+    ///         in the stream being the least significant bit
+    static uint64_t peek(uint64_t buffer, uint32_t bits)
+    {
+        assert(bits > 0 && bits < 64);
+        return buffer & ((uint64_t{1} << bits) - 1);
+    }
+
+    /// @return The buffer with the next bits removed
+    static uint64_t consume(uint64_t buffer, uint32_t bits)
+    {
+        assert(bits < 64);
+        return buffer >> bits;
+    }
+
+    /// @return The number of zero bits before the next one bit
+    static uint32_t zeros(uint64_t buffer)
+    {
+        return buffer ? count_trailing_zeros(buffer) : 64U;
+    }
+
+    /// @return The value of two consecutive reads combined
+    static uint64_t combine(uint64_t first, uint32_t first_bits,
+                            uint64_t second, uint32_t second_bits)
+    {
+        (void) second_bits;
+        return first | (second << first_bits);
+    }
+
+    /// Splits value into the parts written first and second
+    static void split(uint64_t value, uint32_t first_bits,
+                      uint32_t second_bits, uint64_t& first, uint64_t& second)
+    {
+        (void) second_bits;
+        first = value & ((uint64_t{1} << first_bits) - 1);
+        second = value >> first_bits;
+    }
+
+    /// @return The accumulator of a writer with the bits of value added.
+    ///         The first bit in the stream is the least significant bit of
+    ///         the accumulator.
+    static uint64_t push(uint64_t accumulator, uint32_t count,
+                         uint64_t value, uint32_t bits)
+    {
+        assert(count + bits <= 64 && bits < 64);
+        (void) bits;
+        return accumulator | (value << count);
+    }
+
+    /// @return The next complete byte of the accumulator
+    static uint8_t front_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count >= 8);
+        (void) count;
+        return static_cast<uint8_t>(accumulator);
+    }
+
+    /// @return The accumulator with the front byte removed
+    static uint64_t pop_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count >= 8);
+        (void) count;
+        return accumulator >> 8;
+    }
+
+    /// @return The last partial byte padded with zero bits
+    static uint8_t pad_byte(uint64_t accumulator, uint32_t count)
+    {
+        assert(count < 8);
+        (void) count;
+        return static_cast<uint8_t>(accumulator);
+    }
+};
+}
+}
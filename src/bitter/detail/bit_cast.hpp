@@ -0,0 +1,44 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+// GCC 11 and newer can bit cast structs with bit fields in constant
+// expressions, also in C++14 mode
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#define BITTER_HAS_CONSTEXPR_BIT_CAST 1
+#endif
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Function reinterpreting the bytes of from as a To. Usable in
+///        constant expressions if BITTER_HAS_CONSTEXPR_BIT_CAST is defined.
+template<class To, class From>
+#if defined(BITTER_HAS_CONSTEXPR_BIT_CAST)
+constexpr
+#else
+inline
+#endif
+To bit_cast(const From& from)
+{
+    static_assert(sizeof(To) == sizeof(From), "The sizes must be equal");
+    static_assert(std::is_trivially_copyable<From>::value &&
+                  std::is_trivially_copyable<To>::value,
+                  "The types must be trivially copyable");
+
+#if defined(BITTER_HAS_CONSTEXPR_BIT_CAST)
+    return __builtin_bit_cast(To, from);
+#else
+    To to;
+    std::memcpy(&to, &from, sizeof(To));
+    return to;
+#endif
+}
+}
+}
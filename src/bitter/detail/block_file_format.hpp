@@ -0,0 +1,103 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief The format shared by the block_file_writer and
+///        block_file_reader. Everything is stored in 64 bit words:
+///
+///     +--------+---------+-----+---------+-----------+---------+
+///     | header | block 0 | ... | block N | zone maps | trailer |
+///     +--------+---------+-----+---------+-----------+---------+
+///
+/// The header holds the magic value, the records per block, the fields
+/// and the bits of the layout, which are known before the first block is
+/// written. A block holds one column per field with the values of the
+/// field packed back to back (see write_bits(...)), every column starting
+/// at a whole word. The last block is padded to the full block size. The
+/// zone maps hold the minimum and maximum value of every field of every
+/// block, and the trailer the number of records and blocks followed by
+/// the magic value again. Both are written once the last block is, such
+/// that a file is written front to back.
+template<class Layout>
+struct block_file_format
+{
+    /// Value stored first and last in the data to recognize the format
+    static constexpr uint64_t magic = 0x3130534B434F4C42U;
+
+    /// The number of words in the header
+    static constexpr uint64_t header_words = 8;
+
+    /// The number of words in the trailer
+    static constexpr uint64_t trailer_words = 3;
+
+    /// @return The number of words of a column of the field
+    static uint64_t column_words(uint64_t block_records, uint32_t field)
+    {
+        return (block_records * Layout::table::sizes[field] + 63) / 64;
+    }
+
+    /// @return The offset in words of the column of the field in a block
+    static uint64_t column_offset(uint64_t block_records, uint32_t field)
+    {
+        uint64_t offset = 0;
+
+        for (uint32_t i = 0; i < field; ++i)
+        {
+            offset += column_words(block_records, i);
+        }
+
+        return offset;
+    }
+
+    /// @return The number of words in a block
+    static uint64_t block_words(uint64_t block_records)
+    {
+        return column_offset(block_records, Layout::fields);
+    }
+
+    /// @return The offset in words of the block
+    static uint64_t block_offset(uint64_t block_records, uint64_t block)
+    {
+        return header_words + block * block_words(block_records);
+    }
+
+    /// @return The offset in words of the zone map of the field in a
+    ///         block from the first zone map, the minimum followed by the
+    ///         maximum
+    static uint64_t zone_offset(uint64_t block, uint32_t field)
+    {
+        return (block * Layout::fields + field) * 2;
+    }
+
+    /// @return The offset in words of the first zone map
+    static uint64_t zones_offset(uint64_t block_records, uint64_t blocks)
+    {
+        return block_offset(block_records, blocks);
+    }
+
+    /// @return The number of words in a file
+    static uint64_t file_words(uint64_t block_records, uint64_t blocks)
+    {
+        return zones_offset(block_records, blocks) +
+               zone_offset(blocks, 0) + trailer_words;
+    }
+};
+
+template<class Layout>
+constexpr uint64_t block_file_format<Layout>::magic;
+
+template<class Layout>
+constexpr uint64_t block_file_format<Layout>::header_words;
+
+template<class Layout>
+constexpr uint64_t block_file_format<Layout>::trailer_words;
+}
+}
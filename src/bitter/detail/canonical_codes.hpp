@@ -0,0 +1,72 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Function assigning canonical Huffman codes to a list of code
+///        lengths (as in DEFLATE, RFC 1951 section 3.2.2). Shorter codes
+///        come first and codes of equal length are assigned in symbol
+///        order.
+/// @param lengths is the code length of each symbol, zero if unused
+/// @param symbols is the number of symbols
+/// @param max_length is the largest allowed code length
+/// @return The code of each symbol, the first bit of a code being the
+///         most significant of its length bits. Empty if a length is
+///         above max_length or the lengths are over-subscribed i.e. there
+///         are more codes of a length than it can hold, which happens with
+///         corrupt lengths read from a stream.
+inline std::vector<uint32_t> canonical_codes(const uint8_t* lengths,
+                                             uint32_t symbols,
+                                             uint32_t max_length)
+{
+    assert(lengths != nullptr || symbols == 0);
+    assert(max_length <= 32);
+
+    std::vector<uint32_t> counts(max_length + 1, 0);
+
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        if (lengths[i] > max_length)
+        {
+            return { };
+        }
+
+        ++counts[lengths[i]];
+    }
+
+    counts[0] = 0;
+
+    std::vector<uint64_t> next(max_length + 1, 0);
+    uint64_t code = 0;
+
+    for (uint32_t length = 1; length <= max_length; ++length)
+    {
+        code = (code + counts[length - 1]) << 1;
+        next[length] = code;
+
+        if (code + counts[length] > (uint64_t{1} << length))
+        {
+            return { };
+        }
+    }
+
+    std::vector<uint32_t> codes(symbols, 0);
+
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        if (lengths[i] != 0)
+        {
+            codes[i] = static_cast<uint32_t>(next[lengths[i]]++);
+        }
+    }
+
+    return codes;
+}
+}
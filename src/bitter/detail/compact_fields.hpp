@@ -0,0 +1,108 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "sum_sizes.hpp"
+
+#include "../types.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Packs a selection of the fields of a layout into an integer,
+///        with the first selected field in the most significant bits.
+///        Comparing the packed integers compares the fields in order. The
+///        integer is an uint64_t, or an uint128_t for fields of more than
+///        64 bits where the compiler supports it.
+template<class Layout, uint32_t... Fields>
+struct compact_fields
+{
+    static_assert(sizeof...(Fields) > 0, "At least one field must be given");
+
+#if defined(__SIZEOF_INT128__)
+    /// The integer type holding the packed fields
+    using packed_type = typename std::conditional<
+        (sum_sizes<Layout::template field_size<Fields>()...>() <= 64),
+        uint64_t, uint128_t>::type;
+#else
+    /// The integer type holding the packed fields
+    using packed_type = uint64_t;
+#endif
+
+    /// @return The number of bits of the packed fields
+    static constexpr uint32_t bits()
+    {
+        const uint32_t sizes[] = { Layout::template field_size<Fields>()... };
+        uint32_t sum = 0;
+
+        for (uint32_t size : sizes)
+        {
+            sum += size;
+        }
+
+        return sum;
+    }
+
+    static_assert(bits() <= sizeof(packed_type) * 8,
+                  "The fields must fit in 64 bits (128 bits with uint128_t)");
+
+    /// @return The mask of the bits of the fields in the layout, for
+    ///         layouts of up to 64 bits
+    static constexpr uint64_t mask()
+    {
+        const uint32_t offsets[] = { Layout::template field_offset<Fields>()... };
+        const uint32_t sizes[] = { Layout::template field_size<Fields>()... };
+        uint64_t mask = 0;
+
+        for (uint32_t i = 0; i < sizeof...(Fields); ++i)
+        {
+            mask |= (sizes[i] == 64 ? ~uint64_t{0} :
+                     (uint64_t{1} << sizes[i]) - 1) << offsets[i];
+        }
+
+        return mask;
+    }
+
+    /// @return True if the fields are given from the most to the least
+    ///         significant position in the layout. The packed fields are
+    ///         then the bits of mask() in order.
+    static constexpr bool is_descending()
+    {
+        const uint32_t offsets[] = { Layout::template field_offset<Fields>()... };
+
+        for (uint32_t i = 1; i < sizeof...(Fields); ++i)
+        {
+            if (offsets[i] >= offsets[i - 1])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// @return The fields of value packed into the low bits() bits
+    static packed_type get(typename Layout::value_type value)
+    {
+        const uint32_t width = sizeof(packed_type) * 8;
+        packed_type packed = 0;
+
+        // A field as wide as the packed type is the only field, so
+        // shifting by zero instead keeps the shift defined
+        int expand[] = { 0, (packed = (packed <<
+                                       (Layout::template field_size<Fields>() % width)) |
+                                      packed_type(Layout::template get<Fields>(value)), 0)...
+                       };
+        (void) expand;
+
+        return packed;
+    }
+};
+}
+}
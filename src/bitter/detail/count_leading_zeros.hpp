@@ -0,0 +1,31 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function counting the number of zero bits before the most
+///        significant one bit. Compiles to a single lzcnt/bsr instruction.
+/// @param value is the value to count in, must not be zero
+inline uint32_t count_leading_zeros(uint64_t value)
+{
+    assert(value != 0);
+
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63U - index;
+#else
+    return __builtin_clzll(value);
+#endif
+}
+}
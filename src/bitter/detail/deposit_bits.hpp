@@ -0,0 +1,42 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function scattering the low bits of value to the bits selected
+///        by mask (the parallel bit deposit, pdep). The inverse of
+///        extract_bits(...).
+/// @param value is the bits to deposit, starting from bit 0
+/// @param mask is the bits to deposit to
+/// @return The low bits of value placed at the positions of mask in order
+inline uint64_t deposit_bits(uint64_t value, uint64_t mask)
+{
+#if defined(__BMI2__)
+    return _pdep_u64(value, mask);
+#else
+    // One iteration per bit in the mask
+    uint64_t result = 0;
+
+    for (uint64_t bit = 1; mask != 0; bit <<= 1)
+    {
+        if (value & bit)
+        {
+            result |= mask & (0 - mask);
+        }
+
+        mask &= mask - 1;
+    }
+
+    return result;
+#endif
+}
+}
@@ -0,0 +1,42 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function gathering the bits of value selected by mask into the
+///        low bits of the result (the parallel bit extract, pext).
+/// @param value is the value to extract bits from
+/// @param mask is the bits to extract
+/// @return The selected bits of value, packed from bit 0 in the order of
+///         their positions
+inline uint64_t extract_bits(uint64_t value, uint64_t mask)
+{
+#if defined(__BMI2__)
+    return _pext_u64(value, mask);
+#else
+    // One iteration per bit in the mask
+    uint64_t result = 0;
+
+    for (uint64_t bit = 1; mask != 0; bit <<= 1)
+    {
+        if (value & mask & (0 - mask))
+        {
+            result |= bit;
+        }
+
+        mask &= mask - 1;
+    }
+
+    return result;
+#endif
+}
+}
@@ -4,7 +4,7 @@
 // Distributed under the "BSD License". See the accompanying LICENSE.rst file.
 #pragma once
 
-#include "field_mask.hpp"
+#include "field_order.hpp"
 
 #include <cstdint>
 #include <cassert>
@@ -23,9 +23,7 @@ template
 >
 typename DataType::type field_get(typename DataType::type value)
 {
-    uint32_t offset = BitNumbering::template field_offset<Index, Sizes...>();
-    typename DataType::type mask = field_mask<DataType, Index, Sizes...>();
-
-    return (value >> offset) & mask;
+    return detail::field_access<BitNumbering>::template
+           get<DataType, Index, Sizes...>(value);
 }
 }
@@ -0,0 +1,94 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "field_mask.hpp"
+
+#include <cstdint>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Maps a value to the order where every field is a contiguous
+///        range of bits at the field offset given by the bit numbering,
+///        and back. In lsb0 and msb0 mode the fields are already in that
+///        order, bit numberings spreading a field over the value (e.g.
+///        lsb_first and morton) specialize this.
+template<class BitNumbering>
+struct field_order
+{
+    /// @return True if decode(...) and encode(...) leave the value as is
+    static constexpr bool is_identity()
+    {
+        return true;
+    }
+
+    /// @return The value with the fields at their field offsets
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type decode(typename DataType::type value)
+    {
+        return value;
+    }
+
+    /// @return The value with the fields placed by the bit numbering,
+    ///         the inverse of decode(...)
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type encode(typename DataType::type value)
+    {
+        return value;
+    }
+};
+
+/// @brief Reads and writes a single field of a value. By default the value
+///        is mapped with field_order<BitNumbering> and the field masked at
+///        its offset, bit numberings with a cheaper path for a single
+///        field (e.g. morton) specialize this.
+template<class BitNumbering>
+struct field_access
+{
+    /// @return The field at Index of value
+    template<class DataType, uint32_t Index, uint32_t... Sizes>
+    static typename DataType::type get(typename DataType::type value)
+    {
+        uint32_t offset =
+            BitNumbering::template field_offset<Index, Sizes...>();
+        typename DataType::type mask = field_mask<DataType, Index, Sizes...>();
+
+        value = order::template decode<DataType, Sizes...>(value);
+
+        return (value >> offset) & mask;
+    }
+
+    /// @return The bitfield with the field at Index replaced by value
+    template<class DataType, uint32_t Index, uint32_t... Sizes>
+    static typename DataType::type set(typename DataType::type bitfield,
+                                       typename DataType::type value)
+    {
+        uint32_t offset =
+            BitNumbering::template field_offset<Index, Sizes...>();
+        typename DataType::type mask = field_mask<DataType, Index, Sizes...>();
+
+        bitfield = order::template decode<DataType, Sizes...>(bitfield);
+
+        // Shift the value up to where it should go
+        // and do the same with the mask
+        value = value << offset;
+        mask = mask << offset;
+
+        // Merge the bits:
+        // https://graphics.stanford.edu/~seander/bithacks.html#MaskedMerge
+        bitfield = bitfield ^ ((bitfield ^ value) & mask);
+
+        return order::template encode<DataType, Sizes...>(bitfield);
+    }
+
+private:
+
+    /// The order of the fields in the bit numbering
+    using order = field_order<BitNumbering>;
+};
+}
+}
@@ -8,7 +8,7 @@
 #include <cstdint>
 #include <type_traits>
 
-#include "field_mask.hpp"
+#include "field_order.hpp"
 #include "field_max_value.hpp"
 
 namespace bitter
@@ -31,18 +31,7 @@ typename DataType::type field_set(typename DataType::type bitfield,
     assert((value <= field_max_value<DataType, Index, Sizes...>()) &&
            "value exceeds limit representable by available bits");
 
-    uint32_t offset = BitNumbering::template field_offset<Index, Sizes...>();
-    typename DataType::type mask = field_mask<DataType, Index, Sizes...>();
-
-    // Shift the value up to where it should go
-    // and do the same with the mask
-    value = value << offset;
-    mask = mask << offset;
-
-    // Merge the bits:
-    // https://graphics.stanford.edu/~seander/bithacks.html#MaskedMerge
-    bitfield = bitfield ^ ((bitfield ^ value) & mask);
-
-    return bitfield;
+    return detail::field_access<BitNumbering>::template
+           set<DataType, Index, Sizes...>(bitfield, value);
 }
 }
@@ -0,0 +1,178 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "field_mask.hpp"
+#include "field_order.hpp"
+#include "max_sizes.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace bitter
+{
+namespace detail
+{
+template
+<
+    class DataType,
+    class BitNumbering,
+    class Indices,
+    uint32_t... Sizes
+>
+struct field_table;
+
+/// The offset and mask of every field expanded into constexpr arrays at
+/// compile time, such that a field can be looked up by an index which is
+/// only known at runtime.
+template
+<
+    class DataType,
+    class BitNumbering,
+    uint32_t... Indices,
+    uint32_t... Sizes
+>
+struct field_table<DataType, BitNumbering,
+                   std::integer_sequence<uint32_t, Indices...>, Sizes...>
+{
+    using value_type = typename DataType::type;
+
+    /// The number of fields in the table
+    static constexpr uint32_t fields = sizeof...(Sizes);
+
+    /// The size in bits of the fields
+    static constexpr uint32_t sizes[] = { Sizes... };
+
+    /// The offsets of the fields as given by the bit numbering
+    static constexpr uint32_t offsets[] =
+    {
+        BitNumbering::template field_offset<Indices, Sizes...>()...
+    };
+
+    /// The masks of the fields (not shifted to the field offset)
+    static constexpr value_type masks[] =
+    {
+        field_mask<DataType, Indices, Sizes...>()...
+    };
+
+    /// @return The size in bits of the largest field
+    static constexpr uint32_t max_size()
+    {
+        return max_sizes<Sizes...>();
+    }
+
+    /// @return True if all fields have the same size
+    static constexpr bool is_uniform()
+    {
+        for (uint32_t i = 1; i < fields; ++i)
+        {
+            if (sizes[i] != sizes[0])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @return The offset of the field at index. In a uniform layout the
+    ///         offsets form an arithmetic sequence (increasing in LSB 0
+    ///         mode and decreasing in MSB 0 mode) so we compute it instead
+    ///         of loading it from the table.
+    static uint32_t offset(uint32_t index)
+    {
+        assert(index < fields);
+
+        if (is_uniform())
+        {
+            // Unsigned wrap-around makes this work for a decreasing
+            // sequence as well
+            uint32_t stride = fields > 1 ? offsets[1] - offsets[0] : 0;
+            return offsets[0] + index * stride;
+        }
+        else
+        {
+            return offsets[index];
+        }
+    }
+
+    /// @return The mask of the field at index
+    static value_type mask(uint32_t index)
+    {
+        assert(index < fields);
+        return is_uniform() ? masks[0] : masks[index];
+    }
+
+    /// @return The value of the field at index
+    static value_type get(value_type value, uint32_t index)
+    {
+        value = order::template decode<DataType, Sizes...>(value);
+        return (value >> offset(index)) & mask(index);
+    }
+
+    /// @return The bitfield with the field at index replaced by value
+    static value_type set(value_type bitfield, uint32_t index,
+                          value_type value)
+    {
+        assert((value <= mask(index)) &&
+               "value exceeds limit representable by available bits");
+
+        bitfield = order::template decode<DataType, Sizes...>(bitfield);
+
+        uint32_t shift = offset(index);
+        value_type shifted_mask = mask(index) << shift;
+        value_type shifted_value = value << shift;
+
+        return order::template encode<DataType, Sizes...>(
+                   bitfield ^ ((bitfield ^ shifted_value) & shifted_mask));
+    }
+
+private:
+
+    /// The order of the fields in the bit numbering
+    using order = field_order<BitNumbering>;
+};
+
+template
+<
+    class DataType,
+    class BitNumbering,
+    uint32_t... Indices,
+    uint32_t... Sizes
+>
+constexpr uint32_t field_table<DataType, BitNumbering,
+    std::integer_sequence<uint32_t, Indices...>, Sizes...>::sizes[];
+
+template
+<
+    class DataType,
+    class BitNumbering,
+    uint32_t... Indices,
+    uint32_t... Sizes
+>
+constexpr uint32_t field_table<DataType, BitNumbering,
+    std::integer_sequence<uint32_t, Indices...>, Sizes...>::offsets[];
+
+template
+<
+    class DataType,
+    class BitNumbering,
+    uint32_t... Indices,
+    uint32_t... Sizes
+>
+constexpr typename DataType::type field_table<DataType, BitNumbering,
+    std::integer_sequence<uint32_t, Indices...>, Sizes...>::masks[];
+}
+
+/// @brief Tables with the offset and mask of every field in a bit field
+///        layout. Used to access fields by an index known only at runtime:
+///
+///     using table = bitter::field_table<bitter::u32, bitter::lsb0, 8, 24>;
+///     assert(table::offset(1) == 8);
+///
+template<class DataType, class BitNumbering, uint32_t... Sizes>
+using field_table = detail::field_table<DataType, BitNumbering,
+      std::make_integer_sequence<uint32_t, sizeof...(Sizes)>, Sizes...>;
+}
@@ -0,0 +1,99 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "reverse_bits.hpp"
+
+#include "../lsb0.hpp"
+#include "../msb0.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief How a Huffman code appears when peeked from a bit stream with
+///        the given bit numbering. A code is always transmitted starting
+///        with its most significant bit.
+template<class BitNumbering>
+struct huffman_pattern;
+
+/// In MSB 0 mode the first bit in the stream is the most significant bit
+/// of a peeked value, so a code is peeked as-is.
+template<>
+struct huffman_pattern<msb0>
+{
+    /// @return The value of peek(length) when the code is next
+    static uint64_t pattern(uint64_t code, uint32_t length)
+    {
+        (void) length;
+        return code;
+    }
+
+    /// @return The value of peek(bits) when the pattern is next followed
+    ///         by the (bits - length) bits of fill
+    static uint64_t extend(uint64_t pattern, uint32_t length, uint64_t fill,
+                           uint32_t bits)
+    {
+        assert(length <= bits);
+        return (pattern << (bits - length)) | fill;
+    }
+
+    /// @return The first head bits of the pattern
+    static uint64_t head(uint64_t pattern, uint32_t length, uint32_t bits)
+    {
+        assert(bits <= length);
+        return pattern >> (length - bits);
+    }
+
+    /// @return The pattern without the first head bits
+    static uint64_t tail(uint64_t pattern, uint32_t length, uint32_t bits)
+    {
+        assert(bits < length);
+        return pattern & ((uint64_t{1} << (length - bits)) - 1);
+    }
+};
+
+/// In LSB 0 mode the first bit in the stream is the least significant
+/// bit of a peeked value, so a code is peeked bit reversed.
+template<>
+struct huffman_pattern<lsb0>
+{
+    /// @return The value of peek(length) when the code is next
+    static uint64_t pattern(uint64_t code, uint32_t length)
+    {
+        return reverse_bits(code, length);
+    }
+
+    /// @return The value of peek(bits) when the pattern is next followed
+    ///         by the (bits - length) bits of fill
+    static uint64_t extend(uint64_t pattern, uint32_t length, uint64_t fill,
+                           uint32_t bits)
+    {
+        assert(length <= bits);
+        (void) bits;
+        return pattern | (fill << length);
+    }
+
+    /// @return The first head bits of the pattern
+    static uint64_t head(uint64_t pattern, uint32_t length, uint32_t bits)
+    {
+        assert(bits <= length);
+        (void) length;
+        return pattern & ((uint64_t{1} << bits) - 1);
+    }
+
+    /// @return The pattern without the first head bits
+    static uint64_t tail(uint64_t pattern, uint32_t length, uint32_t bits)
+    {
+        assert(bits < length);
+        (void) length;
+        return pattern >> bits;
+    }
+};
+}
+}
@@ -0,0 +1,122 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Masks over all fields (lanes) of a layout computed at compile
+///        time, used for operating on all fields of a value at once
+template<class Layout>
+struct lane_masks
+{
+    static_assert(Layout::bits <= 64,
+                  "Lane masks support layouts of up to 64 bits");
+
+    /// @return The mask of all bits of the layout
+    static constexpr uint64_t all()
+    {
+        return Layout::bits == 64 ? ~uint64_t{0} :
+               (uint64_t{1} << Layout::bits) - 1;
+    }
+
+    /// @return The mask of the most significant bit of every field
+    static constexpr uint64_t top()
+    {
+        uint64_t mask = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            mask |= uint64_t{1} << (Layout::table::offsets[i] +
+                                    Layout::table::sizes[i] - 1);
+        }
+
+        return mask;
+    }
+
+    /// @return The mask of the least significant bit of every field
+    static constexpr uint64_t bottom()
+    {
+        uint64_t mask = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            mask |= uint64_t{1} << Layout::table::offsets[i];
+        }
+
+        return mask;
+    }
+
+    /// @return The mask of all bits except the most significant bit of
+    ///         every field
+    static constexpr uint64_t low()
+    {
+        return all() & ~top();
+    }
+
+    /// @return True if the field at index is the first with its size
+    static constexpr bool starts_size(uint32_t index)
+    {
+        for (uint32_t i = 0; i < index; ++i)
+        {
+            if (Layout::table::sizes[i] == Layout::table::sizes[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// @return The number of different field sizes
+    static constexpr uint32_t sizes()
+    {
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            count += starts_size(i) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    /// @return The size'th different field size
+    static constexpr uint32_t size(uint32_t size)
+    {
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            if (starts_size(i) && size-- == 0)
+            {
+                return Layout::table::sizes[i];
+            }
+        }
+
+        return 0;
+    }
+
+    /// @return The mask of the most significant bit of the fields with
+    ///         the size'th different field size
+    static constexpr uint64_t size_top(uint32_t size)
+    {
+        uint64_t mask = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            if (Layout::table::sizes[i] == lane_masks::size(size))
+            {
+                mask |= uint64_t{1} << (Layout::table::offsets[i] +
+                                        Layout::table::sizes[i] - 1);
+            }
+        }
+
+        return mask;
+    }
+};
+}
+}
@@ -0,0 +1,30 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "load_big_endian.hpp"
+#include "load_little_endian.hpp"
+
+#include "../msb0.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace bitter
+{
+/// @brief Function loading a value of Layout from a byte buffer. The
+///        bytes are in big endian (network) byte order if the layout uses
+///        msb0 and in little endian byte order if it uses lsb0, matching
+///        the order of the bits.
+template<class Layout>
+typename Layout::value_type load_layout(const uint8_t* data)
+{
+    using bitter_type = typename Layout::bitter_type;
+
+    return std::is_same<typename Layout::bit_numbering, msb0>::value ?
+           load_big_endian<bitter_type>(data) :
+           load_little_endian<bitter_type>(data);
+}
+}
@@ -0,0 +1,26 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Function loading DataType::size bytes stored in little endian
+///        byte order. Compilers recognize the pattern and emit a single
+///        load on little endian machines.
+template<class DataType>
+typename DataType::type load_little_endian(const uint8_t* data)
+{
+    typename DataType::type value = 0;
+
+    for (uint32_t i = 0; i < DataType::size; ++i)
+    {
+        value |= static_cast<typename DataType::type>(data[i]) << (i * 8);
+    }
+
+    return value;
+}
+}
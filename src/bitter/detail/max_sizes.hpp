@@ -0,0 +1,26 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Template based functions for getting the size of the largest
+///        field in the variadic template Sizes.
+template<uint32_t Size0>
+constexpr uint32_t max_sizes()
+{
+    return Size0;
+}
+
+template<uint32_t Size0, uint32_t Size1, uint32_t... Sizes>
+constexpr uint32_t max_sizes()
+{
+    return Size0 > max_sizes<Size1, Sizes...>() ?
+           Size0 : max_sizes<Size1, Sizes...>();
+}
+
+}
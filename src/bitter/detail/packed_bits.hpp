@@ -0,0 +1,73 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Function reading a value packed at an arbitrary bit offset into
+///        an array of 64 bit words. Bit i is the bit (i % 64) (LSB 0
+///        numbering) of the word at index i / 64.
+/// @param words is the array to read from
+/// @param offset is the bit offset of the value
+/// @param bits is the number of bits in the value, at most 64
+inline uint64_t read_bits(const uint64_t* words, uint64_t offset,
+                          uint32_t bits)
+{
+    assert(bits <= 64);
+
+    if (bits == 0)
+    {
+        return 0;
+    }
+
+    uint64_t index = offset / 64;
+    uint32_t shift = offset % 64;
+
+    uint64_t value = words[index] >> shift;
+
+    // Funnel in the bits from the next word if the value straddles two
+    if (shift + bits > 64)
+    {
+        value |= words[index + 1] << (64 - shift);
+    }
+
+    return bits == 64 ? value : value & ((uint64_t{1} << bits) - 1);
+}
+
+/// @brief Function writing a value at an arbitrary bit offset into an
+///        array of 64 bit words, see read_bits(...)
+/// @param words is the array to write to
+/// @param offset is the bit offset of the value
+/// @param bits is the number of bits in the value, at most 64
+/// @param value is the value to write, it must fit in the given bits
+inline void write_bits(uint64_t* words, uint64_t offset, uint32_t bits,
+                       uint64_t value)
+{
+    assert(bits <= 64);
+    assert((bits == 64 || (value >> bits) == 0) &&
+           "value exceeds limit representable by available bits");
+
+    if (bits == 0)
+    {
+        return;
+    }
+
+    uint64_t mask = bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+    uint64_t index = offset / 64;
+    uint32_t shift = offset % 64;
+
+    words[index] = (words[index] & ~(mask << shift)) | (value << shift);
+
+    if (shift + bits > 64)
+    {
+        uint32_t rest = 64 - shift;
+        words[index + 1] = (words[index + 1] & ~(mask >> rest)) |
+                           (value >> rest);
+    }
+}
+}
@@ -0,0 +1,25 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function counting the number of one bits in value. Compiles to
+///        a single popcnt instruction where available.
+inline uint32_t popcount(uint64_t value)
+{
+#if defined(_MSC_VER)
+    return static_cast<uint32_t>(__popcnt64(value));
+#else
+    return __builtin_popcountll(value);
+#endif
+}
+}
@@ -0,0 +1,25 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function hinting the processor to load the cache line holding
+///        address, such that a later access does not wait for memory.
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void) address;
+#endif
+}
+}
@@ -0,0 +1,39 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Function reading a range of bits of a byte array in MSB 0 bit
+///        numbering, i.e. bit 0 is the most significant bit of the first
+///        byte (as in e.g. network addresses).
+/// @param data is the bytes to read from
+/// @param offset is the position of the first bit to read
+/// @param bits is the number of bits to read, at most 32
+/// @return The bits with the last bit read as the least significant
+inline uint32_t read_msb0_bits(const uint8_t* data, uint64_t offset,
+                               uint32_t bits)
+{
+    assert(data != nullptr);
+    assert(bits > 0 && bits <= 32);
+
+    uint64_t first = offset / 8;
+    uint64_t last = (offset + bits - 1) / 8;
+    uint64_t window = 0;
+
+    for (uint64_t i = first; i <= last; ++i)
+    {
+        window = (window << 8) | data[i];
+    }
+
+    uint64_t end = (last + 1) * 8;
+    uint64_t mask = (uint64_t{1} << bits) - 1;
+
+    return static_cast<uint32_t>((window >> (end - offset - bits)) & mask);
+}
+}
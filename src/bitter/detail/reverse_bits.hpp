@@ -0,0 +1,41 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function reversing the order of the bits in a 64 bit value
+inline uint64_t reverse_bits(uint64_t value)
+{
+    // Swap neighbouring bits, pairs, nibbles and then the bytes
+    value = ((value >> 1) & 0x5555555555555555U) |
+            ((value & 0x5555555555555555U) << 1);
+    value = ((value >> 2) & 0x3333333333333333U) |
+            ((value & 0x3333333333333333U) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FU) |
+            ((value & 0x0F0F0F0F0F0F0F0FU) << 4);
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+/// @brief Function reversing the order of the lowest bits of value
+/// @param value is the value to reverse, it must fit in the given bits
+/// @param bits is the number of bits to reverse
+inline uint64_t reverse_bits(uint64_t value, uint32_t bits)
+{
+    assert(bits > 0 && bits <= 64);
+    return reverse_bits(value) >> (64 - bits);
+}
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "count_trailing_zeros.hpp"
+#include "popcount.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bitter
+{
+/// @brief Function finding the position of a one bit in value.
+/// @param value is the value to search in
+/// @param rank is the number of one bits before the bit to find (i.e.
+///        zero finds the least significant one bit), it must be less than
+///        popcount(value)
+/// @return The position of the bit (LSB 0 numbering)
+inline uint32_t select_bit(uint64_t value, uint32_t rank)
+{
+    assert(rank < popcount(value));
+
+#if defined(__BMI2__)
+    // Deposit a single bit at the rank'th one bit of value
+    return count_trailing_zeros(_pdep_u64(uint64_t{1} << rank, value));
+#else
+    // Find the byte holding the bit using the prefix sums of the byte
+    // counts, then clear the lower bits of that byte
+    uint64_t counts = value - ((value >> 1) & 0x5555555555555555U);
+    counts = (counts & 0x3333333333333333U) +
+             ((counts >> 2) & 0x3333333333333333U);
+    counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0FU;
+
+    uint64_t prefix = counts * 0x0101010101010101U;
+    uint32_t shift = 0;
+
+    while (((prefix >> shift) & 0xFFU) <= rank)
+    {
+        shift += 8;
+    }
+
+    if (shift > 0)
+    {
+        rank -= (prefix >> (shift - 8)) & 0xFFU;
+    }
+
+    uint64_t byte = (value >> shift) & 0xFFU;
+
+    for (uint32_t i = 0; i < rank; ++i)
+    {
+        byte &= byte - 1;
+    }
+
+    return shift + count_trailing_zeros(byte);
+#endif
+}
+}
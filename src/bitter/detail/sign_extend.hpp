@@ -0,0 +1,24 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+namespace detail
+{
+/// @return The bits of value, a two's complement number of the given size,
+///         as a signed 64 bit value
+inline int64_t sign_extend(uint64_t value, uint32_t bits)
+{
+    assert(bits > 0 && bits <= 64);
+
+    uint32_t shift = 64 - bits;
+    return static_cast<int64_t>(value << shift) >> shift;
+}
+}
+}
@@ -4,6 +4,8 @@
 // Distributed under the "BSD License". See the accompanying LICENSE.rst file.
 #pragma once
 
+#include "../types.hpp"
+
 #include <cstdint>
 
 namespace bitter
@@ -44,4 +46,12 @@ constexpr uint32_t size_in_bits<uint64_t>()
 {
     return sizeof(uint64_t) * 8U;
 }
+
+#if defined(__SIZEOF_INT128__)
+template<>
+constexpr uint32_t size_in_bits<uint128_t>()
+{
+    return sizeof(uint128_t) * 8U;
+}
+#endif
 }
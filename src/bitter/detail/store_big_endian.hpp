@@ -0,0 +1,21 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Function storing the DataType::size least significant bytes of
+///        value in big endian (network) byte order.
+template<class DataType>
+void store_big_endian(typename DataType::type value, uint8_t* data)
+{
+    for (uint32_t i = 0; i < DataType::size; ++i)
+    {
+        data[DataType::size - 1 - i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+}
@@ -0,0 +1,27 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Function reversing the order of the DataType::size bytes of a
+///        value. Compilers recognize the pattern and emit a single byte
+///        swap instruction for the native sizes.
+template<class DataType>
+typename DataType::type swap_bytes(typename DataType::type value)
+{
+    typename DataType::type result = 0;
+
+    for (uint32_t i = 0; i < DataType::size; ++i)
+    {
+        result = (result << 8) | (value & 0xFF);
+        value >>= 8;
+    }
+
+    return result;
+}
+}
@@ -13,12 +13,27 @@ namespace bitter
 {
 namespace detail
 {
+/// Checks for the 128 bit integer, which std::is_unsigned does not know
+/// about in strict ISO C++ mode
+template<class Type>
+struct is_uint128 : std::false_type
+{
+};
+
+#if defined(__SIZEOF_INT128__)
+template<>
+struct is_uint128<uint128_t> : std::true_type
+{
+};
+#endif
+
 /// Base case for BitterTypes (see types.hpp)
 template<class BitterType>
 struct to_type
 {
     static_assert(BitterType::size > 0, "DataType must have size.");
-    static_assert(std::is_unsigned<typename BitterType::type>::value,
+    static_assert(std::is_unsigned<typename BitterType::type>::value ||
+                  is_uint128<typename BitterType::type>::value,
                   "DataType must have a nested type which is unsigned. "
                   "See types.hpp");
 
@@ -49,6 +64,14 @@ struct to_type<uint64_t>
 {
     using type = u64;
 };
+
+#if defined(__SIZEOF_INT128__)
+template<>
+struct to_type<uint128_t>
+{
+    using type = u128;
+};
+#endif
 }
 
 /// Helper function that converts a Type to a BitterType which is
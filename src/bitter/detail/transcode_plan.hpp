@@ -0,0 +1,140 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// Used in a field_map for fields of the target layout which are not
+/// mapped from a source field, the field is set to zero
+static constexpr uint32_t no_field = 0xFFFFFFFFU;
+
+namespace detail
+{
+/// @brief The shift and mask operations needed to move the fields of the
+///        From layout to the To layout, computed at compile time.
+///
+/// Field i of To is taken from field Map[i] of From. Fields moved by the
+/// same distance (the difference in offsets) are moved together with a
+/// single mask and shift, so the operations are grouped by distance:
+/// a mapping keeping the order and sizes of the fields is a single group.
+template<class From, class To, uint32_t... Map>
+struct transcode_plan
+{
+    static_assert(sizeof...(Map) == To::fields,
+                  "The mapping must have an entry for every target field");
+
+    /// @return The source field of the target field at index
+    static constexpr uint32_t source(uint32_t index)
+    {
+        const uint32_t map[] = { Map... };
+        return map[index];
+    }
+
+    /// @return True if the target field at index is taken from a source
+    ///         field
+    static constexpr bool is_mapped(uint32_t index)
+    {
+        return source(index) != no_field;
+    }
+
+    /// @return The distance the target field at index is moved i.e. the
+    ///         left shift (negative for a right shift)
+    static constexpr int32_t distance(uint32_t index)
+    {
+        return int32_t(To::table::offsets[index]) -
+               int32_t(From::table::offsets[source(index)]);
+    }
+
+    /// @return The mask of the source bits of the target field at index.
+    ///         A source field wider than the target field is not
+    ///         truncated, its value must fit in the target field and
+    ///         transcode(...) asserts that. The mask covers the low bits
+    ///         only, so the unused high bits never reach a neighbouring
+    ///         target field.
+    static constexpr uint64_t source_mask(uint32_t index)
+    {
+        uint32_t to_size = To::table::sizes[index];
+        uint32_t from_size = From::table::sizes[source(index)];
+        uint32_t size = to_size < from_size ? to_size : from_size;
+
+        uint64_t mask = size == 64 ? ~uint64_t{0} :
+                        (uint64_t{1} << size) - 1;
+
+        return mask << From::table::offsets[source(index)];
+    }
+
+    /// @return True if the target field at index is the first of the
+    ///         fields moved by its distance
+    static constexpr bool starts_group(uint32_t index)
+    {
+        if (!is_mapped(index))
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < index; ++i)
+        {
+            if (is_mapped(i) && distance(i) == distance(index))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// @return The number of shift and mask operations
+    static constexpr uint32_t groups()
+    {
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < To::fields; ++i)
+        {
+            count += starts_group(i) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    /// @return The first target field of group
+    static constexpr uint32_t group_field(uint32_t group)
+    {
+        for (uint32_t i = 0; i < To::fields; ++i)
+        {
+            if (starts_group(i) && group-- == 0)
+            {
+                return i;
+            }
+        }
+
+        return 0;
+    }
+
+    /// @return The distance the fields of group are moved
+    static constexpr int32_t group_distance(uint32_t group)
+    {
+        return distance(group_field(group));
+    }
+
+    /// @return The mask of the source bits moved by group
+    static constexpr uint64_t group_mask(uint32_t group)
+    {
+        uint64_t mask = 0;
+
+        for (uint32_t i = 0; i < To::fields; ++i)
+        {
+            if (is_mapped(i) && distance(i) == group_distance(group))
+            {
+                mask |= source_mask(i);
+            }
+        }
+
+        return mask;
+    }
+};
+}
+}
@@ -0,0 +1,36 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Transposes a 64 x 64 bit matrix in place, such that bit j of
+///        row i is moved to bit i of row j (LSB 0 numbering).
+///
+/// The matrix is split into four 32 x 32 blocks and the two off diagonal
+/// blocks are swapped, then the same is done for the 16 x 16 blocks etc.
+/// Each step swaps the blocks of all 32 row pairs with a shift and a mask,
+/// so the full transpose is 6 * 32 masked swaps instead of 4096 single bit
+/// moves (see Hacker's Delight, section 7-3).
+/// @param rows is the 64 rows of the matrix
+inline void transpose_64x64(uint64_t* rows)
+{
+    uint64_t mask = 0x00000000FFFFFFFFU;
+
+    for (uint32_t width = 32; width != 0; width >>= 1, mask ^= mask << width)
+    {
+        for (uint32_t k = 0; k < 64; k = ((k | width) + 1) & ~width)
+        {
+            // Swap the upper bits of row k with the lower bits of row
+            // k + width
+            uint64_t swap = ((rows[k] >> width) ^ rows[k | width]) & mask;
+            rows[k | width] ^= swap;
+            rows[k] ^= swap << width;
+        }
+    }
+}
+}
@@ -0,0 +1,234 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/count_leading_zeros.hpp"
+#include "detail/count_trailing_zeros.hpp"
+#include "detail/packed_bits.hpp"
+
+#include "rank_select_bitvector.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Compressed storage of a non-decreasing sequence of integers
+///        using the Elias-Fano encoding.
+///
+/// With n values below a universe u each value is split into its
+/// L = floor(log2(u / n)) low bits, which are packed back to back, and
+/// its high bits which are stored in unary in a rank_select_bitvector:
+/// value i sets the bit at position (value >> L) + i. This uses at most
+/// 2 + log2(u / n) bits per value, e.g. 1 million sorted offsets in a
+/// 4 GB file take about 14 bits each instead of 64.
+///
+/// Access to value i is a select1(i) on the high bits plus a read of the
+/// low bits, next_geq(...) starts from a select0(...) and sequential
+/// decoding walks the high bits a word at a time.
+class elias_fano
+{
+public:
+
+    /// @brief Builds the sequence
+    /// @param values is the values, they must be sorted in non-decreasing
+    ///        order
+    /// @param count is the number of values
+    elias_fano(const uint64_t* values, uint64_t count) :
+        m_size(count),
+        m_low_bits(low_bits(values, count)),
+        m_low(build_low(values, count, m_low_bits)),
+        m_high(build_high(values, count, m_low_bits))
+    {
+    }
+
+    /// @return The number of values
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /// @return The number of bits used for the low part of each value
+    uint32_t low_bits() const
+    {
+        return m_low_bits;
+    }
+
+    /// @return The number of bits used for storing the sequence including
+    ///         the rank/select index
+    uint64_t size_in_bits() const
+    {
+        return m_low.size() * 64 + m_high.data_words() * 64;
+    }
+
+    /// @return The value at index
+    uint64_t at(uint64_t index) const
+    {
+        assert(index < m_size);
+
+        uint64_t high = m_high.select1(index) - index;
+        return (high << m_low_bits) | low(index);
+    }
+
+    /// @return The index of the first value greater than or equal to
+    ///         value, or size() if there is no such value
+    uint64_t next_geq(uint64_t value) const
+    {
+        uint64_t high = value >> m_low_bits;
+        uint64_t zeros = m_high.size() - m_size;
+
+        if (high >= zeros)
+        {
+            return m_size;
+        }
+
+        // The values with high part h follow the h'th zero bit, so skip
+        // straight to the first value with the same high part
+        uint64_t position = high == 0 ? 0 : m_high.select0(high - 1) + 1;
+        uint64_t index = position - high;
+
+        // Scan the ones of the bucket. Once past the bucket (a zero bit)
+        // the next value is larger anyway.
+        uint64_t word_index = position / 64;
+        uint64_t word = m_high.word(word_index) & (~uint64_t{0} << (position % 64));
+
+        while (index < m_size)
+        {
+            while (word == 0)
+            {
+                word = m_high.word(++word_index);
+            }
+
+            uint64_t one = word_index * 64 + count_trailing_zeros(word);
+            uint64_t next = ((one - index) << m_low_bits) | low(index);
+
+            if (next >= value)
+            {
+                return index;
+            }
+
+            word &= word - 1;
+            ++index;
+        }
+
+        return m_size;
+    }
+
+    /// @brief Decodes a range of values
+    /// @param first is the index of the first value to decode
+    /// @param count is the number of values to decode
+    /// @param values is the buffer to write the values to
+    void decode(uint64_t first, uint64_t count, uint64_t* values) const
+    {
+        assert(first + count <= m_size);
+        assert(values != nullptr || count == 0);
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Locate the first value, then walk the high bits a word at a
+        // time clearing the lowest one bit for every value
+        uint64_t position = m_high.select1(first);
+        uint64_t word_index = position / 64;
+        uint64_t word = m_high.word(word_index) & (~uint64_t{0} << (position % 64));
+
+        uint64_t offset = first * m_low_bits;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            while (word == 0)
+            {
+                word = m_high.word(++word_index);
+            }
+
+            uint64_t one = word_index * 64 + count_trailing_zeros(word);
+            uint64_t high = one - (first + i);
+
+            values[i] = (high << m_low_bits) |
+                        read_bits(m_low.data(), offset, m_low_bits);
+
+            word &= word - 1;
+            offset += m_low_bits;
+        }
+    }
+
+private:
+
+    /// @return The low bits of the value at index
+    uint64_t low(uint64_t index) const
+    {
+        return read_bits(m_low.data(), index * m_low_bits, m_low_bits);
+    }
+
+    /// @return The number of low bits, floor(log2(universe / count))
+    static uint32_t low_bits(const uint64_t* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        uint64_t universe = values[count - 1];
+        uint64_t ratio = universe / count;
+
+        return ratio == 0 ? 0 : 63 - count_leading_zeros(ratio);
+    }
+
+    /// @return The packed low bits
+    static std::vector<uint64_t> build_low(const uint64_t* values,
+                                           uint64_t count, uint32_t bits)
+    {
+        std::vector<uint64_t> low((count * bits + 63) / 64 + 1, 0);
+        uint64_t mask = bits == 0 ? 0 : ~uint64_t{0} >> (64 - bits);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            write_bits(low.data(), i * bits, bits, values[i] & mask);
+        }
+
+        return low;
+    }
+
+    /// @return The unary coded high bits
+    static rank_select_bitvector build_high(const uint64_t* values,
+                                            uint64_t count, uint32_t bits)
+    {
+        uint64_t size = count == 0 ? 1 :
+                        count + (values[count - 1] >> bits) + 1;
+
+        std::vector<uint64_t> high((size + 63) / 64, 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            assert((i == 0 || values[i - 1] <= values[i]) &&
+                   "The values must be sorted");
+
+            uint64_t position = (values[i] >> bits) + i;
+            high[position / 64] |= uint64_t{1} << (position % 64);
+        }
+
+        return rank_select_bitvector(high.data(), size);
+    }
+
+private:
+
+    /// The number of values
+    uint64_t m_size;
+
+    /// The number of low bits per value
+    uint32_t m_low_bits;
+
+    /// The packed low bits
+    std::vector<uint64_t> m_low;
+
+    /// The unary coded high bits
+    rank_select_bitvector m_high;
+};
+}
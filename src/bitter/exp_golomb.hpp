@@ -0,0 +1,186 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "bit_stream_reader.hpp"
+#include "bit_stream_writer.hpp"
+#include "detail/count_leading_zeros.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Writes value as an Exp-Golomb code of order K. With K = 0 this
+///        is the ue(v) code of H.264/HEVC:
+///
+///     0 -> 1, 1 -> 010, 2 -> 011, 3 -> 00100, ...
+///
+/// The code is written as a number of zero bits followed by a one bit
+/// and the remaining bits of value + 2^K.
+template<class BitNumbering>
+void exp_golomb_encode(bit_stream_writer<BitNumbering>& writer,
+                       uint64_t value, uint32_t k = 0)
+{
+    assert(k < 64);
+
+    // Values from 2^64 - 2^K have a 65 bit value + 2^K, whose top bit is
+    // the one bit following the zeros
+    uint64_t x = value + (uint64_t{1} << k);
+    uint32_t bits = x < value ? 64 : 63 - count_leading_zeros(x);
+
+    writer.write(0, bits - k);
+    writer.write(1, 1);
+    writer.write(bits == 64 ? x : x & ((uint64_t{1} << bits) - 1), bits);
+}
+
+/// @brief Reads an Exp-Golomb code of order K written with
+///        exp_golomb_encode(...)
+/// @return The value, or zero if the data ended or the code is longer
+///         than any 64 bit value, which makes the reader invalid
+template<class BitNumbering>
+uint64_t exp_golomb_decode(bit_stream_reader<BitNumbering>& reader,
+                           uint32_t k = 0)
+{
+    assert(k < 64);
+
+    uint32_t zeros = 0;
+
+    while (true)
+    {
+        if (reader.buffered_bits() < bit_stream_reader<BitNumbering>::refill_bits)
+        {
+            reader.refill();
+        }
+
+        // The zero prefix is counted with a single lzcnt/tzcnt, only
+        // prefixes longer than the buffer take more than one iteration
+        uint32_t run = reader.count_zeros();
+        zeros += run;
+
+        if (reader.buffered_bits() == 0 || zeros + k > 64)
+        {
+            // The data ended within the prefix or the code is invalid
+            reader.fail();
+            return 0;
+        }
+
+        if (run < reader.buffered_bits())
+        {
+            reader.consume(run + 1);
+            break;
+        }
+
+        reader.consume(run);
+    }
+
+    // The one bit of a 64 bit code is 2^64 and wraps to zero
+    uint32_t bits = zeros + k;
+    uint64_t one = bits < 64 ? uint64_t{1} << bits : 0;
+
+    return one + reader.read(bits) - (uint64_t{1} << k);
+}
+
+/// @brief Writes a signed value as the se(v) Exp-Golomb code of H.264
+///        i.e. the value is mapped to an unsigned code as:
+///
+///     0 -> 0, 1 -> 1, -1 -> 2, 2 -> 3, -2 -> 4, ...
+///
+/// which is the zigzag code of -value, computed in uint64_t such that
+/// INT64_MIN maps to 2^64 - 1.
+template<class BitNumbering>
+void exp_golomb_encode_signed(bit_stream_writer<BitNumbering>& writer,
+                              int64_t value)
+{
+    uint64_t negated = 0 - static_cast<uint64_t>(value);
+    uint64_t sign = 0 - (negated >> 63);
+
+    exp_golomb_encode(writer, (negated << 1) ^ sign);
+}
+
+/// @brief Reads a signed Exp-Golomb code written with
+///        exp_golomb_encode_signed(...)
+template<class BitNumbering>
+int64_t exp_golomb_decode_signed(bit_stream_reader<BitNumbering>& reader)
+{
+    uint64_t code = exp_golomb_decode(reader);
+    uint64_t negated = (code >> 1) ^ (0 - (code & 1));
+
+    // Converting a uint64_t above INT64_MAX to int64_t is implementation
+    // defined before C++20, so the two's complement is spelled out
+    uint64_t value = 0 - negated;
+    return value >> 63 ? -static_cast<int64_t>(~value) - 1 :
+           static_cast<int64_t>(value);
+}
+
+/// @brief Writes an array of values as Exp-Golomb codes of order K
+template<class BitNumbering>
+void exp_golomb_encode(bit_stream_writer<BitNumbering>& writer,
+                       const uint64_t* values, uint64_t count, uint32_t k = 0)
+{
+    assert(values != nullptr || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        exp_golomb_encode(writer, values[i], k);
+    }
+}
+
+/// @brief Reads an array of Exp-Golomb codes of order K. As long as codes
+///        are short several are decoded from the bit buffer before it is
+///        refilled.
+/// @return The number of values decoded, less than count if the data
+///         ended or held an invalid code
+template<class BitNumbering>
+uint64_t exp_golomb_decode(bit_stream_reader<BitNumbering>& reader,
+                       uint64_t* values, uint64_t count, uint32_t k = 0)
+{
+    assert(values != nullptr || count == 0);
+
+    uint64_t i = 0;
+
+    while (i < count)
+    {
+        reader.refill();
+
+        // Decode while the next code is known to be fully buffered
+        while (i < count)
+        {
+            uint32_t zeros = reader.count_zeros();
+            uint32_t length = 2 * zeros + k + 1;
+
+            if (zeros >= reader.buffered_bits() ||
+                length > reader.buffered_bits() ||
+                zeros + k > reader.refill_bits)
+            {
+                break;
+            }
+
+            reader.consume(zeros + 1);
+
+            uint32_t bits = zeros + k;
+            uint64_t rest = bits ? reader.peek(bits) : 0;
+            reader.consume(bits);
+
+            values[i++] = (uint64_t{1} << bits) + rest - (uint64_t{1} << k);
+        }
+
+        // Codes not fully buffered take the general path
+        if (i < count)
+        {
+            values[i] = exp_golomb_decode(reader, k);
+
+            if (!reader.is_valid())
+            {
+                return i;
+            }
+
+            ++i;
+        }
+    }
+
+    return i;
+}
+}
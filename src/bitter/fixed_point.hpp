@@ -0,0 +1,167 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/sign_extend.hpp"
+
+#include "layout.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cassert>
+#include <ratio>
+#include <type_traits>
+
+namespace bitter
+{
+/// @brief A field of a layout holding a fixed point number, i.e. the real
+///        value is raw * Scale + Offset where raw is the field read as an
+///        unsigned or (if Signed) two's complement integer. E.g. a 12 bit
+///        temperature in steps of 1/16 degree starting at -40 degrees:
+///
+///     using frame = bitter::lsb0_layout<uint32_t, 12, 20>;
+///     using temperature = bitter::fixed_point<frame, 0,
+///         std::ratio<1, 16>, std::ratio<-40>>;
+///
+///     float celsius = temperature::get<float>(value);
+///     value = temperature::set(value, 21.5f);
+///
+/// Values are rounded to the nearest step when written and saturated to
+/// the range of the field. NaN (e.g. a failed sensor reading) is written
+/// as the raw value 0.
+template
+<
+    class Layout,
+    uint32_t Index,
+    class Scale,
+    class Offset = std::ratio<0>,
+    bool Signed = false
+>
+struct fixed_point
+{
+    /// The integer type holding a value of the layout
+    using value_type = typename Layout::value_type;
+
+    /// The number of bits of the field
+    static constexpr uint32_t bits = Layout::template field_size<Index>();
+
+    static_assert(bits < 64, "Fixed point fields support up to 63 bits");
+    static_assert(Scale::num > 0, "The scale must be positive");
+
+    /// The smallest raw value of the field
+    static constexpr int64_t raw_min =
+        Signed ? -(int64_t{1} << (bits - 1)) : 0;
+
+    /// The largest raw value of the field
+    static constexpr int64_t raw_max =
+        Signed ? (int64_t{1} << (bits - 1)) - 1 : (int64_t{1} << bits) - 1;
+
+    /// @return The real value of a raw field
+    template<class Float>
+    static Float to_float(value_type raw)
+    {
+        static_assert(std::is_floating_point<Float>::value,
+                      "Float must be a floating point type");
+
+        // Fields fitting in 32 bits are converted from 32 bit integers,
+        // which compilers can vectorize on more targets
+        using integer_type = typename std::conditional<
+            (bits < 32), int32_t, int64_t>::type;
+
+        integer_type integer = static_cast<integer_type>(
+            Signed ? detail::sign_extend(raw, bits) : int64_t(raw));
+
+        return static_cast<Float>(integer) * scale<Float>() + offset<Float>();
+    }
+
+    /// @return The raw field of a real value, rounded to the nearest step
+    ///         and saturated to the range of the field, or 0 for NaN
+    template<class Float>
+    static value_type from_float(Float real)
+    {
+        static_assert(std::is_floating_point<Float>::value,
+                      "Float must be a floating point type");
+
+        double steps = std::round((static_cast<double>(real) -
+                                   offset<double>()) / scale<double>());
+
+        // NaN fails both saturation checks and cannot be converted
+        int64_t raw = std::isnan(steps) ? 0 :
+                      steps <= double(raw_min) ? raw_min :
+                      steps >= double(raw_max) ? raw_max :
+                      static_cast<int64_t>(steps);
+
+        uint64_t mask = (uint64_t{1} << bits) - 1;
+        return static_cast<value_type>(static_cast<uint64_t>(raw) & mask);
+    }
+
+    /// @return The real value of the field of value
+    template<class Float>
+    static Float get(value_type value)
+    {
+        return to_float<Float>(Layout::template get<Index>(value));
+    }
+
+    /// @return The value with the field set to the real value
+    template<class Float>
+    static value_type set(value_type value, Float real)
+    {
+        return Layout::template set<Index>(value, from_float(real));
+    }
+
+    /// @brief Converts the field of an array of values into an array of
+    ///        real values, e.g. a float column for further processing.
+    ///        The loop has no branches, so compilers vectorize it.
+    template<class Float>
+    static void get(const value_type* values, uint64_t count, Float* output)
+    {
+        assert((values != nullptr && output != nullptr) || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            output[i] = get<Float>(values[i]);
+        }
+    }
+
+    /// @brief Sets the field of an array of values from an array of real
+    ///        values
+    template<class Float>
+    static void set(value_type* values, uint64_t count, const Float* input)
+    {
+        assert((values != nullptr && input != nullptr) || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            values[i] = set(values[i], input[i]);
+        }
+    }
+
+private:
+
+    /// @return The scale as a floating point number
+    template<class Float>
+    static constexpr Float scale()
+    {
+        return static_cast<Float>(Scale::num) / static_cast<Float>(Scale::den);
+    }
+
+    /// @return The offset as a floating point number
+    template<class Float>
+    static constexpr Float offset()
+    {
+        return static_cast<Float>(Offset::num) /
+               static_cast<Float>(Offset::den);
+    }
+};
+
+template<class Layout, uint32_t Index, class Scale, class Offset, bool Signed>
+constexpr uint32_t fixed_point<Layout, Index, Scale, Offset, Signed>::bits;
+
+template<class Layout, uint32_t Index, class Scale, class Offset, bool Signed>
+constexpr int64_t fixed_point<Layout, Index, Scale, Offset, Signed>::raw_min;
+
+template<class Layout, uint32_t Index, class Scale, class Offset, bool Signed>
+constexpr int64_t fixed_point<Layout, Index, Scale, Offset, Signed>::raw_max;
+}
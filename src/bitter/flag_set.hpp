@@ -0,0 +1,184 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/popcount.hpp"
+#include "detail/transpose_64x64.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <initializer_list>
+
+namespace bitter
+{
+namespace detail
+{
+/// @return True if the fields First to First + Count of the layout are 1
+///         bit fields
+template<class Layout, uint32_t First, uint32_t Count>
+constexpr bool is_flag_run()
+{
+    for (uint32_t i = First; i < First + Count; ++i)
+    {
+        if (Layout::table::sizes[i] != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+/// @brief A run of 1 bit fields of a layout used as flags named by an
+///        enum, e.g. the control bits of a TCP header:
+///
+///     enum class tcp_flag { ns, cwr, ece, urg, ack, psh, rst, syn, fin };
+///
+///     using control = bitter::msb0_layout<uint16_t, 4, 3,
+///         1, 1, 1, 1, 1, 1, 1, 1, 1>;
+///     using flags = bitter::flag_set<control, tcp_flag, 2>;
+///
+///     auto syn_ack = flags::mask({tcp_flag::syn, tcp_flag::ack});
+///     if (flags::test_all(value, syn_ack)) { ... }
+///
+/// Flag f is the field First + f of the layout. The masks are computed at
+/// compile time from the field offsets, so testing, setting or clearing a
+/// whole set of flags is a single and/or on the value.
+template
+<
+    class Layout,
+    class Enum,
+    uint32_t First = 0,
+    uint32_t Count = Layout::fields - First
+>
+struct flag_set
+{
+    /// The integer type holding a value of the layout
+    using value_type = typename Layout::value_type;
+
+    /// The enum naming the flags
+    using flag_type = Enum;
+
+    /// The number of flags
+    static constexpr uint32_t flags = Count;
+
+    static_assert(Count > 0 && First + Count <= Layout::fields,
+                  "The flags must be fields of the layout");
+
+    static_assert(detail::is_flag_run<Layout, First, Count>(),
+                  "The flags must be 1 bit fields");
+
+    /// @return The mask of a flag
+    static constexpr value_type mask(Enum flag)
+    {
+        return value_type(1) << Layout::table::offsets[index(flag)];
+    }
+
+    /// @return The mask of a set of flags
+    static constexpr value_type mask(std::initializer_list<Enum> flags)
+    {
+        value_type result = 0;
+
+        for (Enum flag : flags)
+        {
+            result |= mask(flag);
+        }
+        return result;
+    }
+
+    /// @return The mask of all the flags
+    static constexpr value_type all()
+    {
+        value_type result = 0;
+
+        for (uint32_t i = First; i < First + Count; ++i)
+        {
+            result |= value_type(1) << Layout::table::offsets[i];
+        }
+        return result;
+    }
+
+    /// @return True if the flag is set in value
+    static bool test(value_type value, Enum flag)
+    {
+        return (value & mask(flag)) != 0;
+    }
+
+    /// @return True if any of the flags of mask is set in value
+    static bool test_any(value_type value, value_type mask)
+    {
+        return (value & mask) != 0;
+    }
+
+    /// @return True if all of the flags of mask are set in value
+    static bool test_all(value_type value, value_type mask)
+    {
+        return (value & mask) == mask;
+    }
+
+    /// @return The value with the flags of mask set
+    static value_type set(value_type value, value_type mask)
+    {
+        assert((mask & ~all()) == 0 && "The mask contains other fields");
+        return value | mask;
+    }
+
+    /// @return The value with the flags of mask cleared
+    static value_type clear(value_type value, value_type mask)
+    {
+        assert((mask & ~all()) == 0 && "The mask contains other fields");
+        return value & ~mask;
+    }
+
+    /// @brief Counts how many values have each flag set. The values are
+    ///        transposed 64 at a time such that each bit of the values
+    ///        becomes a word, and a flag is counted with a popcount of
+    ///        its word.
+    /// @param values is the values to count
+    /// @param count is the number of values
+    /// @param counts is the Count counters to add the number of values
+    ///        with each flag set to
+    static void count(const value_type* values, uint64_t count,
+                      uint64_t* counts)
+    {
+        static_assert(sizeof(value_type) <= sizeof(uint64_t),
+                      "Counting supports values of up to 64 bits");
+
+        assert((values != nullptr || count == 0) && counts != nullptr);
+
+        uint64_t rows[64];
+
+        for (uint64_t group = 0; group < count; group += 64)
+        {
+            for (uint64_t i = 0; i < 64; ++i)
+            {
+                rows[i] = group + i < count ? uint64_t(values[group + i]) : 0;
+            }
+
+            // After the transpose row k holds bit k of the 64 values
+            transpose_64x64(rows);
+
+            for (uint32_t i = 0; i < Count; ++i)
+            {
+                counts[i] += popcount(rows[Layout::table::offsets[First + i]]);
+            }
+        }
+    }
+
+private:
+
+    /// @return The field index of a flag
+    static constexpr uint32_t index(Enum flag)
+    {
+        assert(static_cast<uint32_t>(flag) < Count && "Invalid flag");
+        return First + static_cast<uint32_t>(flag);
+    }
+};
+
+template<class Layout, class Enum, uint32_t First, uint32_t Count>
+constexpr uint32_t flag_set<Layout, Enum, First, Count>::flags;
+}
@@ -0,0 +1,203 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/count_leading_zeros.hpp"
+#include "detail/count_trailing_zeros.hpp"
+
+#include "bit_stream_reader.hpp"
+#include "bit_stream_writer.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Encoder of a series of 64 bit words (e.g. packed samples where
+///        most fields rarely change) as in the Gorilla time series
+///        database. Every word is XORed with the previous word (the first
+///        with zero) and the XOR is written as:
+///
+///     0                        the word is unchanged
+///     1 0 <bits>               the changed bits are within the window of
+///                              the previous XOR, only the window is written
+///     1 1 <6> <6> <bits>       the number of leading zeros, the number of
+///                              meaningful bits - 1 and the meaningful bits
+///                              which then become the new window
+///
+/// The previous window is only reused if that is not longer than opening
+/// a new window, such that a wide window (e.g. of the first word) does
+/// not inflate every following small change.
+///
+template<class BitNumbering>
+class gorilla_encoder
+{
+public:
+
+    /// @brief Encoder constructor
+    /// @param writer is the stream to write to
+    explicit gorilla_encoder(bit_stream_writer<BitNumbering>& writer) :
+        m_writer(writer)
+    {
+    }
+
+    /// @brief Writes the next word of the series
+    void encode(uint64_t value)
+    {
+        uint64_t x = value ^ m_previous;
+        m_previous = value;
+
+        if (x == 0)
+        {
+            m_writer.write(0, 1);
+            return;
+        }
+
+        m_writer.write(1, 1);
+
+        uint32_t leading = count_leading_zeros(x);
+        uint32_t trailing = count_trailing_zeros(x);
+        uint32_t bits = 64 - leading - trailing;
+
+        if (m_bits != 0 && leading >= m_leading && trailing >= m_trailing &&
+            m_bits <= bits + 12)
+        {
+            m_writer.write(0, 1);
+            m_writer.write(x >> m_trailing, m_bits);
+            return;
+        }
+
+        m_leading = leading;
+        m_trailing = trailing;
+        m_bits = bits;
+
+        m_writer.write(1, 1);
+        m_writer.write(m_leading, 6);
+        m_writer.write(m_bits - 1, 6);
+        m_writer.write(x >> m_trailing, m_bits);
+    }
+
+    /// @brief Writes an array of words of the series
+    void encode(const uint64_t* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            encode(values[i]);
+        }
+    }
+
+private:
+
+    /// The stream to write to
+    bit_stream_writer<BitNumbering>& m_writer;
+
+    /// The previous word
+    uint64_t m_previous = 0;
+
+    /// The leading zeros of the window
+    uint32_t m_leading = 0;
+
+    /// The trailing zeros of the window
+    uint32_t m_trailing = 0;
+
+    /// The number of bits in the window, zero before the first window
+    uint32_t m_bits = 0;
+};
+
+/// @brief Decoder of a series of 64 bit words written by a
+///        gorilla_encoder
+template<class BitNumbering>
+class gorilla_decoder
+{
+public:
+
+    /// @brief Decoder constructor
+    /// @param reader is the stream to read from
+    explicit gorilla_decoder(bit_stream_reader<BitNumbering>& reader) :
+        m_reader(reader)
+    {
+    }
+
+    /// @return The next word of the series. A window beyond 64 bits or a
+    ///         reused window before the first one is invalid, it makes the
+    ///         reader invalid (see bit_stream_reader::is_valid()) and zero
+    ///         is returned.
+    uint64_t decode()
+    {
+        // A word takes at most 2 + 12 + 64 bits, refill once for all but
+        // the longest ones
+        if (m_reader.buffered_bits() < 14)
+        {
+            m_reader.refill();
+        }
+
+        if (m_reader.read(1) == 0)
+        {
+            return m_previous;
+        }
+
+        if (m_reader.read(1) != 0)
+        {
+            m_leading = static_cast<uint32_t>(m_reader.read(6));
+            m_bits = static_cast<uint32_t>(m_reader.read(6)) + 1;
+
+            if (m_leading + m_bits > 64)
+            {
+                m_bits = 0;
+            }
+
+            m_trailing = 64 - m_leading - m_bits;
+        }
+
+        if (m_bits == 0)
+        {
+            m_reader.fail();
+            return 0;
+        }
+
+        m_previous ^= m_reader.read(m_bits) << m_trailing;
+        return m_previous;
+    }
+
+    /// @brief Reads an array of words of the series
+    /// @return The number of words decoded, less than count if the stream
+    ///         ended or held an invalid code
+    uint64_t decode(uint64_t* values, uint64_t count)
+    {
+        assert(values != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            values[i] = decode();
+
+            if (!m_reader.is_valid())
+            {
+                return i;
+            }
+        }
+
+        return count;
+    }
+
+private:
+
+    /// The stream to read from
+    bit_stream_reader<BitNumbering>& m_reader;
+
+    /// The previous word
+    uint64_t m_previous = 0;
+
+    /// The leading zeros of the window
+    uint32_t m_leading = 0;
+
+    /// The trailing zeros of the window
+    uint32_t m_trailing = 0;
+
+    /// The number of bits in the window
+    uint32_t m_bits = 0;
+};
+}
@@ -0,0 +1,293 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "bit_stream_reader.hpp"
+#include "detail/canonical_codes.hpp"
+#include "detail/huffman_pattern.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Decoder for canonical Huffman codes given by their code lengths
+///        (as used in DEFLATE, JPEG etc.).
+///
+/// The decoder builds a two level lookup table: The root table is indexed
+/// by the next root_bits bits of the stream and resolves all codes of up
+/// to root_bits bits in a single lookup. Longer codes point to a sub table
+/// indexed by the following bits. Since the bit buffer of the
+/// bit_stream_reader holds at least 56 bits after a refill, several
+/// symbols are decoded per refill.
+template<class BitNumbering>
+class huffman_decoder
+{
+public:
+
+    /// The largest supported code length
+    static constexpr uint32_t max_code_length = 32;
+
+    /// The symbol returned for an invalid code or when reading past the
+    /// end of the data
+    static constexpr uint32_t invalid_symbol = 0xFFFFFFFFU;
+
+    /// @brief Decoder constructor
+    /// @param lengths is the code length of each symbol, zero if unused
+    /// @param symbols is the number of symbols
+    /// @param root_bits is the number of bits used to index the root table
+    ///
+    /// The lengths may come from an untrusted stream. Lengths above
+    /// max_code_length or over-subscribed lengths make the decoder invalid,
+    /// see is_valid().
+    huffman_decoder(const uint8_t* lengths, uint32_t symbols,
+                    uint32_t root_bits = 10)
+    {
+        assert(lengths != nullptr || symbols == 0);
+        assert(root_bits > 0 && root_bits <= 16);
+
+        std::vector<uint32_t> codes =
+            canonical_codes(lengths, symbols, max_code_length);
+
+        if (codes.size() != symbols)
+        {
+            return;
+        }
+
+        m_valid = true;
+
+        for (uint32_t i = 0; i < symbols; ++i)
+        {
+            m_max_length = lengths[i] > m_max_length ?
+                           lengths[i] : m_max_length;
+        }
+
+        m_root_bits = root_bits < m_max_length ? root_bits : m_max_length;
+        m_root_bits = m_root_bits > 0 ? m_root_bits : 1;
+
+        const entry invalid = { invalid_symbol, 0, 0 };
+        m_table.assign(uint64_t{1} << m_root_bits, invalid);
+
+        // Find the size of the sub table of each root table entry: it
+        // must hold the longest code starting with the entry
+        std::vector<uint8_t> sub_bits(m_table.size(), 0);
+
+        for (uint32_t i = 0; i < symbols; ++i)
+        {
+            uint32_t length = lengths[i];
+
+            if (length > m_root_bits)
+            {
+                uint64_t head = pattern::head(
+                    pattern::pattern(codes[i], length), length, m_root_bits);
+
+                uint32_t bits = length - m_root_bits;
+                sub_bits[head] = bits > sub_bits[head] ? bits : sub_bits[head];
+            }
+        }
+
+        for (uint64_t head = 0; head < sub_bits.size(); ++head)
+        {
+            if (sub_bits[head] != 0)
+            {
+                m_table[head] = { static_cast<uint32_t>(m_table.size()),
+                                  static_cast<uint8_t>(m_root_bits),
+                                  sub_bits[head]
+                                };
+
+                m_table.resize(m_table.size() + (1U << sub_bits[head]),
+                               invalid);
+            }
+        }
+
+        // Fill in the symbols. A code shorter than the table index
+        // occupies all entries where the remaining bits vary.
+        for (uint32_t i = 0; i < symbols; ++i)
+        {
+            uint32_t length = lengths[i];
+
+            if (length == 0)
+            {
+                continue;
+            }
+
+            uint64_t bits = pattern::pattern(codes[i], length);
+
+            if (length <= m_root_bits)
+            {
+                fill(0, bits, length, m_root_bits, i);
+            }
+            else
+            {
+                uint64_t head = pattern::head(bits, length, m_root_bits);
+                uint64_t tail = pattern::tail(bits, length, m_root_bits);
+
+                entry sub_table = m_table[head];
+                fill(sub_table.value, tail, length - m_root_bits,
+                     sub_table.sub_bits, i);
+            }
+        }
+    }
+
+    /// @return True if the code lengths were valid. An invalid decoder has
+    ///         no table and decodes nothing.
+    bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    /// @return The length of the longest code
+    uint32_t max_length() const
+    {
+        return m_max_length;
+    }
+
+    /// @return The next symbol in the stream or invalid_symbol
+    uint32_t decode(bit_stream_reader<BitNumbering>& reader) const
+    {
+        if (!m_valid)
+        {
+            return invalid_symbol;
+        }
+
+        if (reader.buffered_bits() < m_max_length)
+        {
+            reader.refill();
+        }
+
+        return decode_buffered(reader);
+    }
+
+    /// @brief Decodes an array of symbols
+    /// @param reader is the bit stream to read from
+    /// @param symbols is the buffer to write the symbols to
+    /// @param count is the number of symbols to decode
+    /// @return The number of symbols decoded, less than count if an
+    ///         invalid code or the end of the data was reached
+    uint64_t decode(bit_stream_reader<BitNumbering>& reader,
+                    uint32_t* symbols, uint64_t count) const
+    {
+        assert(symbols != nullptr || count == 0);
+
+        if (!m_valid)
+        {
+            return 0;
+        }
+
+        uint64_t i = 0;
+
+        while (i < count)
+        {
+            reader.refill();
+
+            // Decode until the buffer may no longer hold a whole code
+            while (i < count && reader.buffered_bits() >= m_max_length)
+            {
+                uint32_t symbol = decode_buffered(reader);
+
+                if (symbol == invalid_symbol)
+                {
+                    return i;
+                }
+
+                symbols[i++] = symbol;
+            }
+
+            // Close to the end of the data the last codes may be shorter
+            // than the longest code
+            if (i < count)
+            {
+                uint32_t symbol = decode(reader);
+
+                if (symbol == invalid_symbol)
+                {
+                    return i;
+                }
+
+                symbols[i++] = symbol;
+            }
+        }
+
+        return i;
+    }
+
+private:
+
+    /// Small alias for the code patterns
+    using pattern = detail::huffman_pattern<BitNumbering>;
+
+    /// An entry in the lookup table. If sub_bits is non zero the entry
+    /// points to a sub table at value indexed by the next sub_bits bits,
+    /// otherwise value is the symbol and length the number of bits to
+    /// consume.
+    struct entry
+    {
+        uint32_t value;
+        uint8_t length;
+        uint8_t sub_bits;
+    };
+
+    /// Fills the entries of the table starting at offset which are
+    /// reached by the code bits followed by any fill bits
+    void fill(uint32_t offset, uint64_t bits, uint32_t length,
+              uint32_t table_bits, uint32_t symbol)
+    {
+        const entry value = { symbol, static_cast<uint8_t>(length), 0 };
+
+        for (uint64_t fill = 0; fill < (uint64_t{1} << (table_bits - length));
+             ++fill)
+        {
+            m_table[offset + pattern::extend(bits, length, fill, table_bits)] =
+                value;
+        }
+    }
+
+    /// Decodes a symbol using the bits already in the buffer
+    uint32_t decode_buffered(bit_stream_reader<BitNumbering>& reader) const
+    {
+        const entry* e = &m_table[reader.peek(m_root_bits)];
+
+        if (e->sub_bits != 0)
+        {
+            if (e->length > reader.buffered_bits())
+            {
+                return invalid_symbol;
+            }
+
+            reader.consume(e->length);
+            e = &m_table[e->value + reader.peek(e->sub_bits)];
+        }
+
+        if (e->length > reader.buffered_bits())
+        {
+            return invalid_symbol;
+        }
+
+        reader.consume(e->length);
+        return e->value;
+    }
+
+private:
+
+    /// The lookup table, the root table followed by the sub tables
+    std::vector<entry> m_table;
+
+    /// The number of bits indexing the root table
+    uint32_t m_root_bits = 0;
+
+    /// The length of the longest code
+    uint32_t m_max_length = 0;
+
+    /// True if the code lengths were valid
+    bool m_valid = false;
+};
+
+template<class BitNumbering>
+constexpr uint32_t huffman_decoder<BitNumbering>::max_code_length;
+
+template<class BitNumbering>
+constexpr uint32_t huffman_decoder<BitNumbering>::invalid_symbol;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "bit_stream_writer.hpp"
+#include "detail/canonical_codes.hpp"
+#include "detail/huffman_pattern.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Encoder for canonical Huffman codes given by their code lengths,
+///        the counterpart of the huffman_decoder.
+template<class BitNumbering>
+class huffman_encoder
+{
+public:
+
+    /// The largest supported code length
+    static constexpr uint32_t max_code_length = 32;
+
+    /// @brief Encoder constructor
+    /// @param lengths is the code length of each symbol, zero if unused
+    /// @param symbols is the number of symbols
+    ///
+    /// Lengths above max_code_length or over-subscribed lengths make the
+    /// encoder invalid and leave it without symbols, see is_valid().
+    huffman_encoder(const uint8_t* lengths, uint32_t symbols)
+    {
+        assert(lengths != nullptr || symbols == 0);
+
+        std::vector<uint32_t> codes =
+            canonical_codes(lengths, symbols, max_code_length);
+
+        if (codes.size() != symbols)
+        {
+            return;
+        }
+
+        m_valid = true;
+        m_lengths.assign(lengths, lengths + symbols);
+        m_patterns.assign(symbols, 0);
+
+        for (uint32_t i = 0; i < symbols; ++i)
+        {
+            if (m_lengths[i] != 0)
+            {
+                m_patterns[i] = pattern::pattern(codes[i], m_lengths[i]);
+            }
+        }
+    }
+
+    /// @return True if the code lengths were valid
+    bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    /// @brief Writes the code of symbol to the stream
+    void encode(bit_stream_writer<BitNumbering>& writer, uint32_t symbol) const
+    {
+        assert(symbol < m_lengths.size());
+        assert(m_lengths[symbol] != 0 && "The symbol has no code");
+
+        writer.write(m_patterns[symbol], m_lengths[symbol]);
+    }
+
+    /// @brief Writes the codes of an array of symbols to the stream
+    void encode(bit_stream_writer<BitNumbering>& writer,
+                const uint32_t* symbols, uint64_t count) const
+    {
+        assert(symbols != nullptr || count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            encode(writer, symbols[i]);
+        }
+    }
+
+private:
+
+    /// Small alias for the code patterns
+    using pattern = detail::huffman_pattern<BitNumbering>;
+
+    /// The code length of each symbol
+    std::vector<uint8_t> m_lengths;
+
+    /// The code of each symbol in the order it is written to the stream
+    std::vector<uint64_t> m_patterns;
+
+    /// True if the code lengths were valid
+    bool m_valid = false;
+};
+
+template<class BitNumbering>
+constexpr uint32_t huffman_encoder<BitNumbering>::max_code_length;
+}
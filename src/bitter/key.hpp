@@ -0,0 +1,144 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/compact_fields.hpp"
+#include "detail/extract_bits.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+
+namespace bitter
+{
+/// @brief A key made of a selection of the fields of a layout, e.g. the
+///        addresses, ports and protocol of a packet header for a flow
+///        table:
+///
+///     using flow = bitter::key<header, 0, 1, 3>;
+///
+///     flow::key_type k = flow::get(value);
+///     uint64_t h = flow::hash(k);
+///
+/// The selected fields are packed into the smallest unsigned integer type
+/// holding them, with the first selected field in the most significant
+/// bits. If the selected fields are given from the most to the least
+/// significant position the packing is a single pext when BMI2 is
+/// available, otherwise the fields are shifted into place.
+///
+/// Keys of more than 64 bits, like the 104 bits of an IPv4 5-tuple, are
+/// packed into an uint128_t where the compiler supports it (the layout is
+/// then a u104 to u128 type as well):
+///
+///     using header = bitter::msb0_layout<bitter::u104, 32, 32, 16, 16, 8>;
+///     using flow = bitter::key<header, 0, 1, 2, 3, 4>;
+///
+/// Other compilers support keys of up to 64 bits.
+template<class Layout, uint32_t... Fields>
+struct key
+{
+    /// The type of the values of the layout
+    using value_type = typename Layout::value_type;
+
+    /// The number of bits of the key
+    static constexpr uint32_t bits =
+        detail::compact_fields<Layout, Fields...>::bits();
+
+    /// The smallest unsigned integer type holding the key
+    using key_type =
+        typename std::conditional<(bits <= 8), uint8_t,
+        typename std::conditional<(bits <= 16), uint16_t,
+        typename std::conditional<(bits <= 32), uint32_t,
+        typename detail::compact_fields<Layout, Fields...>::packed_type
+        >::type>::type>::type;
+
+    /// @return The key of value
+    static key_type get(value_type value)
+    {
+        return static_cast<key_type>(get(value, use_extract()));
+    }
+
+    /// @return A hash of key with all bits depending on all bits of the
+    ///         key (the finalizer of MurmurHash3). A key of more than 64
+    ///         bits is hashed a word at a time, the hash of the high word
+    ///         being mixed into the low word.
+    static uint64_t hash(key_type key)
+    {
+        return hash(key, std::integral_constant<bool, (bits > 64)>());
+    }
+
+    /// @brief Computes the keys and hashes of an array of values, e.g. for
+    ///        a burst of packets so the hash table buckets of all of them
+    ///        can be prefetched before the lookups
+    /// @param values is the values
+    /// @param count is the number of values
+    /// @param keys is the count keys to write
+    /// @param hashes is the count hashes to write
+    static void get(const value_type* values, uint64_t count, key_type* keys,
+                    uint64_t* hashes)
+    {
+        assert((values != nullptr && keys != nullptr && hashes != nullptr) ||
+               count == 0);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            keys[i] = get(values[i]);
+        }
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            hashes[i] = hash(keys[i]);
+        }
+    }
+
+private:
+
+    using fields = detail::compact_fields<Layout, Fields...>;
+
+#if defined(__BMI2__)
+    using use_extract = std::integral_constant<bool,
+          fields::is_descending() && Layout::bits <= 64>;
+#else
+    using use_extract = std::false_type;
+#endif
+
+    static uint64_t get(value_type value, std::true_type)
+    {
+        return extract_bits(value, fields::mask());
+    }
+
+    static typename fields::packed_type get(value_type value, std::false_type)
+    {
+        return fields::get(value);
+    }
+
+    /// @return The MurmurHash3 finalizer of a word
+    static uint64_t mix(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDU;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53U;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint64_t hash(key_type key, std::false_type)
+    {
+        return mix(key);
+    }
+
+    static uint64_t hash(key_type key, std::true_type)
+    {
+        return mix(static_cast<uint64_t>(key) ^
+                   mix(static_cast<uint64_t>(key >> 64)));
+    }
+};
+
+template<class Layout, uint32_t... Fields>
+constexpr uint32_t key<Layout, Fields...>::bits;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/field_get.hpp"
+#include "detail/field_mask.hpp"
+#include "detail/field_order.hpp"
+#include "detail/field_set.hpp"
+#include "detail/field_size_in_bits.hpp"
+#include "detail/field_table.hpp"
+#include "detail/size_in_bits.hpp"
+#include "detail/sum_sizes.hpp"
+#include "detail/to_type.hpp"
+
+#include "reader.hpp"
+#include "writer.hpp"
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Describes a bit field layout i.e. the data type, the bit
+///        numbering and the sizes of the fields, as used by the reader
+///        and writer. Algorithms working on many values of the same
+///        layout (column splitting, SWAR arithmetic etc.) take a layout
+///        as their template argument:
+///
+///     using header = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+///
+template<typename Type, typename BitNumbering, uint32_t... Sizes>
+struct layout
+{
+    /// Get the bitter type
+    using bitter_type = to_type<Type>;
+
+    /// The integer type holding a value of the layout
+    using value_type = typename bitter_type::type;
+
+    /// The bit numbering of the layout
+    using bit_numbering = BitNumbering;
+
+    /// The reader for the layout
+    using reader_type = reader<Type, BitNumbering, Sizes...>;
+
+    /// The writer for the layout
+    using writer_type = writer<Type, BitNumbering, Sizes...>;
+
+    /// The offset and mask tables of the fields
+    using table = field_table<bitter_type, BitNumbering, Sizes...>;
+
+    static_assert(size_in_bits<bitter_type>() == sum_sizes<Sizes...>(),
+                  "size of the DataType is not equal to the sum of sizes");
+
+    // The algorithms over layouts work on the fields in place, so every
+    // field must be a contiguous range of bits
+    static_assert(detail::field_order<BitNumbering>::is_identity(),
+                  "layouts support the lsb0 and msb0 bit numberings");
+
+    /// The number of fields
+    static constexpr uint32_t fields = sizeof...(Sizes);
+
+    /// The number of bits in the layout
+    static constexpr uint32_t bits = sum_sizes<Sizes...>();
+
+    /// @return The size in bits of the field at Index
+    template<uint32_t Index>
+    static constexpr uint32_t field_size()
+    {
+        return field_size_in_bits<Index, Sizes...>();
+    }
+
+    /// @return The shift offset of the field at Index
+    template<uint32_t Index>
+    static constexpr uint32_t field_offset()
+    {
+        return BitNumbering::template field_offset<Index, Sizes...>();
+    }
+
+    /// @return The mask of the field at Index (not shifted to the offset)
+    template<uint32_t Index>
+    static constexpr value_type field_mask()
+    {
+        return bitter::field_mask<bitter_type, Index, Sizes...>();
+    }
+
+    /// @return The field at Index of value
+    template<uint32_t Index>
+    static value_type get(value_type value)
+    {
+        return field_get<bitter_type, BitNumbering, Index, Sizes...>(value);
+    }
+
+    /// @return The value with the field at Index replaced
+    template<uint32_t Index>
+    static value_type set(value_type value, value_type field)
+    {
+        return field_set<bitter_type, BitNumbering, Index, Sizes...>(
+                   value, field);
+    }
+};
+
+template<typename Type, typename BitNumbering, uint32_t... Sizes>
+constexpr uint32_t layout<Type, BitNumbering, Sizes...>::fields;
+
+template<typename Type, typename BitNumbering, uint32_t... Sizes>
+constexpr uint32_t layout<Type, BitNumbering, Sizes...>::bits;
+}
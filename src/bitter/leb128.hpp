@@ -0,0 +1,208 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/count_trailing_zeros.hpp"
+#include "detail/load_little_endian.hpp"
+
+#include "types.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bitter
+{
+/// The maximum number of bytes used for encoding a 64 bit value
+static const uint32_t leb128_max_size = 10;
+
+/// @return The number of bytes needed for encoding the value
+inline uint32_t leb128_size(uint64_t value)
+{
+    uint32_t size = 1;
+
+    while (value >= 0x80U)
+    {
+        value >>= 7;
+        ++size;
+    }
+
+    return size;
+}
+
+/// @brief Encodes an unsigned value as (unsigned) LEB128. Each byte holds
+///        7 bits of the value starting with the least significant bits,
+///        the most significant bit of a byte is set if more bytes follow.
+/// @param value is the value to encode
+/// @param data is the buffer to write to, it must have room for
+///        leb128_size(value) bytes
+/// @return The number of bytes written
+inline uint32_t leb128_encode(uint64_t value, uint8_t* data)
+{
+    assert(data != nullptr);
+
+    uint32_t size = 0;
+
+    while (value >= 0x80U)
+    {
+        data[size++] = static_cast<uint8_t>(value | 0x80U);
+        value >>= 7;
+    }
+
+    data[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+/// @brief Encodes an array of unsigned values as LEB128
+/// @param values is the values to encode
+/// @param count is the number of values
+/// @param data is the buffer to write to, it must have room for
+///        count * leb128_max_size bytes
+/// @return The number of bytes written
+inline uint64_t leb128_encode(const uint64_t* values, uint64_t count,
+                              uint8_t* data)
+{
+    assert(values != nullptr || count == 0);
+
+    uint64_t size = 0;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        size += leb128_encode(values[i], data + size);
+    }
+
+    return size;
+}
+
+namespace detail
+{
+/// @return The 7 bit groups of the 8 bytes in word packed together i.e.
+///         the bits selected by the mask 0x7f7f7f7f7f7f7f7f
+inline uint64_t leb128_compact(uint64_t word)
+{
+#if defined(__BMI2__)
+    return _pext_u64(word, 0x7F7F7F7F7F7F7F7FU);
+#else
+    // Merge neighbouring groups in three steps: 7 -> 14 -> 28 -> 56 bits
+    word = (word & 0x007F007F007F007FU) | ((word & 0x7F007F007F007F00U) >> 1);
+    word = (word & 0x00003FFF00003FFFU) | ((word & 0x3FFF00003FFF0000U) >> 2);
+    word = (word & 0x000000000FFFFFFFU) | ((word & 0x0FFFFFFF00000000U) >> 4);
+    return word;
+#endif
+}
+
+/// Decodes a value one byte at a time
+inline uint32_t leb128_decode_bytes(const uint8_t* data, uint64_t size,
+                                    uint64_t& value)
+{
+    uint64_t result = 0;
+    uint64_t limit = size < leb128_max_size ? size : leb128_max_size;
+
+    for (uint32_t i = 0; i < limit; ++i)
+    {
+        // The last byte holds bit 63 only and ends the value
+        if (i == leb128_max_size - 1 && (data[i] & 0xFEU) != 0)
+        {
+            return 0;
+        }
+
+        result |= static_cast<uint64_t>(data[i] & 0x7FU) << (7 * i);
+
+        if ((data[i] & 0x80U) == 0)
+        {
+            value = result;
+            return i + 1;
+        }
+    }
+
+    // The data was truncated
+    return 0;
+}
+}
+
+/// @brief Decodes an unsigned LEB128 value
+/// @param data is the buffer to read from
+/// @param size is the size of the buffer in bytes
+/// @param value is set to the decoded value
+/// @return The number of bytes read, or zero if the data does not hold a
+///         complete value or the value does not fit in 64 bits
+inline uint32_t leb128_decode(const uint8_t* data, uint64_t size,
+                              uint64_t& value)
+{
+    assert(data != nullptr || size == 0);
+
+    if (size >= 8)
+    {
+        // Fast path: Values of up to 8 bytes are decoded from a single
+        // load. The terminating byte is the first without the high bit.
+        uint64_t word = load_little_endian<u64>(data);
+        uint64_t stops = ~word & 0x8080808080808080U;
+
+        if (stops != 0)
+        {
+            uint32_t bytes = (count_trailing_zeros(stops) >> 3) + 1;
+            uint64_t bits = detail::leb128_compact(word);
+
+            value = bytes == 8 ? bits : bits & ((uint64_t{1} << (7 * bytes)) - 1);
+            return bytes;
+        }
+    }
+
+    return detail::leb128_decode_bytes(data, size, value);
+}
+
+/// @brief Decodes an array of unsigned LEB128 values
+/// @param data is the buffer to read from
+/// @param size is the size of the buffer in bytes
+/// @param values is the buffer to write the decoded values to
+/// @param count is the number of values to decode
+/// @return The number of bytes read, or zero if the data does not hold
+///         count complete values of up to 64 bits
+inline uint64_t leb128_decode(const uint8_t* data, uint64_t size,
+                              uint64_t* values, uint64_t count)
+{
+    assert(data != nullptr || size == 0);
+    assert(values != nullptr || count == 0);
+
+    uint64_t offset = 0;
+    uint64_t i = 0;
+
+    while (i < count)
+    {
+        if (size - offset >= 8 && count - i >= 8)
+        {
+            uint64_t word = load_little_endian<u64>(data + offset);
+
+            // Fast path: Eight single byte values
+            if ((word & 0x8080808080808080U) == 0)
+            {
+                for (uint32_t j = 0; j < 8; ++j)
+                {
+                    values[i + j] = (word >> (8 * j)) & 0xFFU;
+                }
+
+                offset += 8;
+                i += 8;
+                continue;
+            }
+        }
+
+        uint32_t read = leb128_decode(data + offset, size - offset, values[i]);
+
+        if (read == 0)
+        {
+            return 0;
+        }
+
+        offset += read;
+        i += 1;
+    }
+
+    return offset;
+}
+}
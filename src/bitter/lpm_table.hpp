@@ -0,0 +1,423 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/prefetch.hpp"
+#include "detail/read_msb0_bits.hpp"
+#include "detail/store_big_endian.hpp"
+
+#include "lsb0_layout.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Longest prefix match table for keys of KeyBits bits, e.g. IPv4
+///        or IPv6 routes, as a multi-bit trie.
+///
+/// The keys are byte arrays in MSB 0 bit numbering (network byte order),
+/// or for IPv4 and IPv6 uint32_t and uint128_t (bitter::u128) integers,
+/// and prefixes are the first length bits of a key. The first RootBits
+/// bits of a key index the root table, each following StrideBits bits
+/// index a child table. With RootBits = 24 and StrideBits = 8 this is the
+/// DIR-24-8 scheme, where most IPv4 lookups are a single memory access:
+///
+///     bitter::ipv4_lpm_table table;
+///     table.insert(0x0A000000U, 8, 1);   // 10.0.0.0/8 -> 1
+///     table.insert(0x0A010200U, 24, 2);  // 10.1.2.0/24 -> 2
+///
+///     assert(table.lookup(0x0A010203U) == 2);
+///     assert(table.lookup(0x0A020203U) == 1);
+///
+/// Prefixes longer than the root bits are expanded into their table, so
+/// every table entry holds the value of the longest prefix covering it.
+/// An entry is a single 32 bit word:
+///
+///      31   30   29       22 21                    0
+///     +----+----+-----------+-----------------------+
+///     | v  | c  | length    | value or child table  |
+///     +----+----+-----------+-----------------------+
+///
+/// where v is set if a prefix covers the entry and c if the entry points
+/// to a child table (the length is then that of the prefix covering the
+/// whole child table). The 22 bits limit both the values and the number
+/// of child tables to max_value + 1, an insert which would need more
+/// child tables fails.
+template<uint32_t KeyBits, uint32_t RootBits, uint32_t StrideBits>
+class lpm_table
+{
+public:
+
+    static_assert(KeyBits % 8 == 0 && KeyBits <= 248,
+                  "The keys must be whole bytes");
+    static_assert(RootBits > 0 && RootBits <= 24, "Invalid root bits");
+    static_assert(StrideBits > 0 && StrideBits <= 24, "Invalid stride bits");
+    static_assert(RootBits <= KeyBits &&
+                  (KeyBits - RootBits) % StrideBits == 0,
+                  "The strides must add up to the key bits");
+
+    /// The number of bytes of a key
+    static constexpr uint32_t key_bytes = KeyBits / 8;
+
+    /// The largest value which can be stored
+    static constexpr uint32_t max_value = (1U << 22) - 1;
+
+    /// Returned by lookups if no prefix matches
+    static constexpr uint32_t no_match = 0xFFFFFFFFU;
+
+    /// @brief Constructs an empty table
+    lpm_table() :
+        m_entries(uint64_t{1} << RootBits, 0)
+    {
+    }
+
+    /// @brief Adds a prefix, replacing the value of an equal prefix
+    /// @param prefix is the key_bytes bytes of the prefix, the bits after
+    ///        the first length bits are ignored
+    /// @param length is the number of bits of the prefix
+    /// @param value is the value returned for keys matching the prefix
+    /// @return False if the value exceeds max_value or the table is out of
+    ///         child tables, the lookups are then unchanged
+    bool insert(const uint8_t* prefix, uint32_t length, uint32_t value)
+    {
+        assert(prefix != nullptr);
+        assert(length <= KeyBits);
+
+        if (value > max_value)
+        {
+            return false;
+        }
+
+        uint64_t table = 0;
+        uint32_t offset = 0;
+        uint32_t bits = RootBits;
+
+        while (true)
+        {
+            uint64_t index = read_msb0_bits(prefix, offset, bits);
+
+            if (length <= offset + bits)
+            {
+                // Set all entries starting with the prefix
+                uint64_t count = uint64_t{1} << (offset + bits - length);
+                index = table + (index & ~(count - 1));
+
+                for (uint64_t i = index; i < index + count; ++i)
+                {
+                    update(i, length, value);
+                }
+
+                return true;
+            }
+
+            index += table;
+            entry_type entry = m_entries[index];
+
+            if (!entry::get<2>(entry))
+            {
+                // A new child table repeats the entry it replaces, so the
+                // child tables added before running out change no lookups
+                if (children() > max_value)
+                {
+                    return false;
+                }
+
+                entry = add_child(entry);
+                m_entries[index] = entry;
+            }
+
+            table = child_table(entry::get<0>(entry));
+            offset += bits;
+            bits = StrideBits;
+        }
+    }
+
+    /// @brief Adds a prefix of a 32 bit key
+    bool insert(uint32_t prefix, uint32_t length, uint32_t value)
+    {
+        static_assert(KeyBits == 32, "Only valid for 32 bit keys");
+
+        uint8_t key[4];
+        store_big_endian<u32>(prefix, key);
+        return insert(key, length, value);
+    }
+
+#if defined(__SIZEOF_INT128__)
+    /// @brief Adds a prefix of a 128 bit key
+    bool insert(uint128_t prefix, uint32_t length, uint32_t value)
+    {
+        static_assert(KeyBits == 128, "Only valid for 128 bit keys");
+
+        uint8_t key[16];
+        store_big_endian<u128>(prefix, key);
+        return insert(key, length, value);
+    }
+#endif
+
+    /// @return The value of the longest prefix matching the key, or
+    ///         no_match if no prefix matches
+    /// @param key is the key_bytes bytes of the key
+    uint32_t lookup(const uint8_t* key) const
+    {
+        assert(key != nullptr);
+
+        return find([key](uint32_t offset, uint32_t bits)
+        {
+            return read_msb0_bits(key, offset, bits);
+        });
+    }
+
+    /// @return The value of the longest prefix matching a 32 bit key
+    uint32_t lookup(uint32_t key) const
+    {
+        static_assert(KeyBits == 32, "Only valid for 32 bit keys");
+
+        return find([key](uint32_t offset, uint32_t bits)
+        {
+            return integer_bits(key, offset, bits);
+        });
+    }
+
+#if defined(__SIZEOF_INT128__)
+    /// @return The value of the longest prefix matching a 128 bit key
+    uint32_t lookup(uint128_t key) const
+    {
+        static_assert(KeyBits == 128, "Only valid for 128 bit keys");
+
+        return find([key](uint32_t offset, uint32_t bits)
+        {
+            return integer_bits(key, offset, bits);
+        });
+    }
+#endif
+
+    /// @brief Looks up many keys. The keys are processed in groups, where
+    ///        the table entries of all keys of the group are prefetched
+    ///        before they are read, so the memory accesses of the keys
+    ///        overlap instead of waiting for each other.
+    /// @param keys is the count keys of key_bytes bytes each
+    /// @param count is the number of keys
+    /// @param values is the count values to write, see lookup(...)
+    void lookup(const uint8_t* keys, uint64_t count, uint32_t* values) const
+    {
+        assert((keys != nullptr && values != nullptr) || count == 0);
+
+        find(count, values, [keys](uint64_t i, uint32_t offset, uint32_t bits)
+        {
+            return read_msb0_bits(keys + i * key_bytes, offset, bits);
+        });
+    }
+
+    /// @brief Looks up many 32 bit keys, see lookup(keys, count, values)
+    void lookup(const uint32_t* keys, uint64_t count, uint32_t* values) const
+    {
+        static_assert(KeyBits == 32, "Only valid for 32 bit keys");
+        assert((keys != nullptr && values != nullptr) || count == 0);
+
+        find(count, values, [keys](uint64_t i, uint32_t offset, uint32_t bits)
+        {
+            return integer_bits(keys[i], offset, bits);
+        });
+    }
+
+#if defined(__SIZEOF_INT128__)
+    /// @brief Looks up many 128 bit keys, see lookup(keys, count, values)
+    void lookup(const uint128_t* keys, uint64_t count, uint32_t* values) const
+    {
+        static_assert(KeyBits == 128, "Only valid for 128 bit keys");
+        assert((keys != nullptr && values != nullptr) || count == 0);
+
+        find(count, values, [keys](uint64_t i, uint32_t offset, uint32_t bits)
+        {
+            return integer_bits(keys[i], offset, bits);
+        });
+    }
+#endif
+
+    /// @return The number of child tables
+    uint64_t children() const
+    {
+        return (m_entries.size() - (uint64_t{1} << RootBits)) >> StrideBits;
+    }
+
+    /// @return The number of bytes used by the tables
+    uint64_t size_in_bytes() const
+    {
+        return m_entries.size() * sizeof(entry_type);
+    }
+
+private:
+
+    /// The layout of an entry: value or child table, prefix length, child
+    /// table flag and valid flag
+    using entry = lsb0_layout<uint32_t, 22, 8, 1, 1>;
+
+    /// The type of an entry
+    using entry_type = entry::value_type;
+
+    /// @return The bits of an integer key at the MSB 0 offset
+    template<class Integer>
+    static uint64_t integer_bits(Integer key, uint32_t offset, uint32_t bits)
+    {
+        assert(offset + bits <= KeyBits && bits < 64);
+        return static_cast<uint64_t>(key >> (KeyBits - offset - bits)) &
+               ((uint64_t{1} << bits) - 1);
+    }
+
+    /// @return The value of the longest prefix matching the key, where
+    ///         key_bits(offset, bits) returns the bits of the key
+    template<class KeyBitsFunction>
+    uint32_t find(KeyBitsFunction key_bits) const
+    {
+        const entry_type* entries = m_entries.data();
+
+        uint32_t offset = RootBits;
+        entry_type entry = entries[key_bits(0, RootBits)];
+
+        while (entry::get<2>(entry))
+        {
+            uint64_t index = child_table(entry::get<0>(entry)) +
+                             key_bits(offset, StrideBits);
+            entry = entries[index];
+            offset += StrideBits;
+        }
+
+        return entry::get<3>(entry) ? entry::get<0>(entry) : no_match;
+    }
+
+    /// @brief Looks up count keys in groups, where key_bits(i, offset,
+    ///        bits) returns the bits of key i
+    template<class KeyBitsFunction>
+    void find(uint64_t count, uint32_t* values,
+              KeyBitsFunction key_bits) const
+    {
+        const uint32_t group = 16;
+        uint64_t index[group];
+        uint32_t offset[group];
+
+        for (uint64_t first = 0; first < count; first += group)
+        {
+            uint32_t size = static_cast<uint32_t>(
+                std::min<uint64_t>(group, count - first));
+
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                index[i] = key_bits(first + i, 0, RootBits);
+                offset[i] = RootBits;
+                prefetch(&m_entries[index[i]]);
+            }
+
+            // Every round reads an entry of each unresolved key and
+            // prefetches the entry of the next level
+            uint32_t pending = size;
+
+            while (pending > 0)
+            {
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    if (offset[i] > KeyBits)
+                    {
+                        continue;
+                    }
+
+                    entry_type entry = m_entries[index[i]];
+
+                    if (entry::get<2>(entry))
+                    {
+                        index[i] = child_table(entry::get<0>(entry)) +
+                                   key_bits(first + i, offset[i], StrideBits);
+                        offset[i] += StrideBits;
+                        prefetch(&m_entries[index[i]]);
+                    }
+                    else
+                    {
+                        values[first + i] = entry::get<3>(entry) ?
+                                            entry::get<0>(entry) : no_match;
+
+                        // Mark the key as resolved
+                        offset[i] = KeyBits + 1;
+                        --pending;
+                    }
+                }
+            }
+        }
+    }
+
+    /// @return The index of the first entry of a child table
+    static uint64_t child_table(uint64_t child)
+    {
+        return (uint64_t{1} << RootBits) + (child << StrideBits);
+    }
+
+    /// @return The entry pointing to a new child table in which all entries
+    ///         have the value of the given entry
+    entry_type add_child(entry_type parent)
+    {
+        uint64_t child = children();
+        assert(child <= max_value && "Too many child tables");
+
+        m_entries.resize(m_entries.size() + (uint64_t{1} << StrideBits),
+                         parent);
+
+        return entry::set<2>(entry::set<0>(parent, static_cast<uint32_t>(child)), 1);
+    }
+
+    /// @brief Sets an entry to a prefix unless it is covered by a longer
+    ///        prefix. A child table is updated in all its entries.
+    void update(uint64_t index, uint32_t length, uint32_t value)
+    {
+        entry_type current = m_entries[index];
+
+        if (entry::get<3>(current) && entry::get<1>(current) > length)
+        {
+            return;
+        }
+
+        if (entry::get<2>(current))
+        {
+            m_entries[index] = entry::set<3>(
+                entry::set<1>(current, length), 1);
+
+            uint64_t table = child_table(entry::get<0>(current));
+
+            for (uint64_t i = table; i < table + (uint64_t{1} << StrideBits); ++i)
+            {
+                update(i, length, value);
+            }
+        }
+        else
+        {
+            entry_type updated = entry::set<0>(0, value);
+            updated = entry::set<1>(updated, length);
+            m_entries[index] = entry::set<3>(updated, 1);
+        }
+    }
+
+private:
+
+    /// The root table followed by the child tables
+    std::vector<entry_type> m_entries;
+};
+
+template<uint32_t KeyBits, uint32_t RootBits, uint32_t StrideBits>
+constexpr uint32_t lpm_table<KeyBits, RootBits, StrideBits>::key_bytes;
+
+template<uint32_t KeyBits, uint32_t RootBits, uint32_t StrideBits>
+constexpr uint32_t lpm_table<KeyBits, RootBits, StrideBits>::max_value;
+
+template<uint32_t KeyBits, uint32_t RootBits, uint32_t StrideBits>
+constexpr uint32_t lpm_table<KeyBits, RootBits, StrideBits>::no_match;
+
+/// @brief Longest prefix match of IPv4 addresses using DIR-24-8
+using ipv4_lpm_table = lpm_table<32, 24, 8>;
+
+/// @brief Longest prefix match of IPv6 addresses using a 16 bit root table
+///        and 8 bit strides
+using ipv6_lpm_table = lpm_table<128, 16, 8>;
+}
@@ -40,7 +40,7 @@ struct lsb0
     /// interested in.
     ///
     template<uint32_t Index, uint32_t... Sizes>
-    static uint32_t field_offset()
+    static constexpr uint32_t field_offset()
     {
         return count_to_field_offset<Index, 0, Sizes...>();
     }
@@ -53,7 +53,7 @@ private:
         uint32_t Counter,
         uint32_t Size0
     >
-    static uint32_t count_to_field_offset()
+    static constexpr uint32_t count_to_field_offset()
     {
         static_assert(Index == Counter, "");
         return 0;
@@ -67,7 +67,7 @@ private:
         uint32_t Size1,
         uint32_t... Sizes
     >
-    static uint32_t count_to_field_offset()
+    static constexpr uint32_t count_to_field_offset()
     {
         if (Index == Counter)
         {
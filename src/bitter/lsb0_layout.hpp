@@ -0,0 +1,14 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "layout.hpp"
+
+namespace bitter
+{
+/// @brief Layout with the fields placed in LSB 0 bit numbering
+template<typename DataType, uint32_t... Sizes>
+using lsb0_layout = layout<DataType, lsb0, Sizes...>;
+}
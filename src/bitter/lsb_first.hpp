@@ -0,0 +1,74 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/field_order.hpp"
+#include "detail/swap_bytes.hpp"
+
+#include "lsb0.hpp"
+
+#include <cstdint>
+
+namespace bitter
+{
+/// @brief Calculates the bit offsets given that bitter is configured in
+///        LSB first mode: the bytes of the value are numbered from the
+///        most significant byte (as sent in big endian) and the bits of
+///        every byte from the least significant bit, as used by protocols
+///        sending the bits of every byte LSB first (e.g. UART based
+///        serial links and several radio formats).
+struct lsb_first
+{
+    /// The fields follow each other in the order they are sent and the
+    /// first bit sent of a field is its least significant bit. A field
+    /// crossing a byte boundary is therefore split in the value.
+    ///
+    /// Example, a u16 with the field sizes 4, 8, 4 holding the value
+    /// 0xABCD i.e. the bytes 0xAB and 0xCD are sent in that order:
+    ///
+    /// bits sent:  0 - 3     4 - 7     8 - 11    12 - 15
+    ///           +---------+---------+---------+---------+
+    ///           |   0xB   |   0xA   |   0xD   |   0xC   |
+    ///           +---------+---------+---------+---------+
+    /// field:    |    0    |         1         |    2    |
+    ///
+    /// So field 0 is 0xB, field 1 is 0xDA (its first bits sent are the
+    /// least significant) and field 2 is 0xC. Swapping the bytes of the
+    /// value makes every field contiguous at its LSB 0 offset, which is
+    /// how the fields are accessed (see detail::field_order).
+    ///
+    template<uint32_t Index, uint32_t... Sizes>
+    static constexpr uint32_t field_offset()
+    {
+        return lsb0::field_offset<Index, Sizes...>();
+    }
+};
+
+namespace detail
+{
+/// The fields of a value in LSB first mode are contiguous once the bytes
+/// are swapped
+template<>
+struct field_order<lsb_first>
+{
+    static constexpr bool is_identity()
+    {
+        return false;
+    }
+
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type decode(typename DataType::type value)
+    {
+        return swap_bytes<DataType>(value);
+    }
+
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type encode(typename DataType::type value)
+    {
+        return swap_bytes<DataType>(value);
+    }
+};
+}
+}
@@ -0,0 +1,85 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Merges the field at Index of count values from input
+template<class Layout, uint32_t Index, class Input>
+void merge_column(typename Layout::value_type* data, uint64_t count,
+                  const Input* input)
+{
+    using value_type = typename Layout::value_type;
+
+    assert(input != nullptr || count == 0);
+
+    const uint32_t offset = Layout::template field_offset<Index>();
+    const value_type mask = Layout::template field_mask<Index>();
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        value_type value = static_cast<value_type>(input[i]);
+
+        assert(value <= mask &&
+               "value exceeds limit representable by available bits");
+
+        data[i] |= (value & mask) << offset;
+    }
+}
+
+template<class Layout, uint32_t... Indices, class... Inputs>
+void merge_columns(std::integer_sequence<uint32_t, Indices...>,
+                   typename Layout::value_type* data, uint64_t count,
+                   const Inputs*... inputs)
+{
+    std::fill(data, data + count, 0);
+
+    int expand[] = { 0, (merge_column<Layout, Indices>(
+                             data, count, inputs), 0)...
+                   };
+    (void) expand;
+}
+}
+
+/// @brief Merges one array per field into an array of values of a layout
+///        (structure of arrays to array of structures), the inverse of
+///        split_columns(...):
+///
+///     bitter::merge_columns<header>(headers, count, version.data(),
+///                                   length.data(), id.data());
+///
+/// @param data is the array of count values to write
+/// @param count is the number of values
+/// @param inputs is one array of count elements per field, each element
+///        must fit in the field
+template<class Layout, class... Inputs>
+void merge_columns(typename Layout::value_type* data, uint64_t count,
+                   const Inputs*... inputs)
+{
+    static_assert(sizeof...(Inputs) == Layout::fields,
+                  "There must be an input for every field");
+
+    assert(data != nullptr || count == 0);
+
+    const uint64_t chunk = 1024;
+
+    for (uint64_t first = 0; first < count; first += chunk)
+    {
+        detail::merge_columns<Layout>(
+            std::make_integer_sequence<uint32_t, Layout::fields>(),
+            data + first, std::min(chunk, count - first),
+            (inputs + first)...);
+    }
+}
+}
@@ -0,0 +1,181 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/deposit_bits.hpp"
+#include "detail/extract_bits.hpp"
+#include "detail/field_mask.hpp"
+#include "detail/field_order.hpp"
+#include "detail/size_in_bits.hpp"
+
+#include "lsb0.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace bitter
+{
+/// @brief Calculates the bit positions given that bitter is configured in
+///        Morton (Z-order) mode: the bits of the fields are interleaved,
+///        such that values compare like their fields walked along a
+///        Z-order curve, e.g. for spatial index keys.
+struct morton
+{
+    /// Starting from bit 0 the value holds bit 0 of every field in index
+    /// order, then bit 1 of every field etc. Once a field runs out of
+    /// bits the remaining fields continue without it.
+    ///
+    /// Example with a u8 and the field sizes 3, 3, 2 (x, y and z):
+    ///
+    /// bit index:   7   6   5   4   3   2   1   0
+    ///            +---+---+---+---+---+---+---+---+
+    ///            | y2| x2| z1| y1| x1| z0| y0| x0|
+    ///            +---+---+---+---+---+---+---+---+
+    ///
+    /// A field is read by gathering its bits into a contiguous range
+    /// (pext) and written by scattering them back (pdep), leaving the
+    /// bits of the other fields untouched. The offset is the offset of
+    /// the field in the value with all fields gathered, which uses LSB 0
+    /// numbering.
+    ///
+    template<uint32_t Index, uint32_t... Sizes>
+    static constexpr uint32_t field_offset()
+    {
+        return lsb0::field_offset<Index, Sizes...>();
+    }
+
+    /// @return The bits of the value holding the field at Index
+    template<uint32_t Index, uint32_t... Sizes>
+    static constexpr uint64_t field_bits()
+    {
+        const uint32_t sizes[] = { Sizes... };
+
+        uint64_t bits = 0;
+        uint32_t position = 0;
+
+        for (uint32_t level = 0; level < 64; ++level)
+        {
+            for (uint32_t i = 0; i < sizeof...(Sizes); ++i)
+            {
+                if (level < sizes[i])
+                {
+                    if (i == Index)
+                    {
+                        bits |= uint64_t{1} << position;
+                    }
+
+                    ++position;
+                }
+            }
+        }
+
+        return bits;
+    }
+};
+
+namespace detail
+{
+/// The fields of a value in Morton mode are gathered into their LSB 0
+/// positions and scattered back
+template<>
+struct field_order<morton>
+{
+    static constexpr bool is_identity()
+    {
+        return false;
+    }
+
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type decode(typename DataType::type value)
+    {
+        static_assert(size_in_bits<DataType>() <= 64,
+                      "Morton mode supports values of up to 64 bits");
+
+        return gather<DataType, Sizes...>(
+            value, std::make_integer_sequence<uint32_t, sizeof...(Sizes)>());
+    }
+
+    template<class DataType, uint32_t... Sizes>
+    static typename DataType::type encode(typename DataType::type value)
+    {
+        static_assert(size_in_bits<DataType>() <= 64,
+                      "Morton mode supports values of up to 64 bits");
+
+        return scatter<DataType, Sizes...>(
+            value, std::make_integer_sequence<uint32_t, sizeof...(Sizes)>());
+    }
+
+private:
+
+    /// Gathers the bits of every field with extract_bits(...)
+    template<class DataType, uint32_t... Sizes, uint32_t... Indices>
+    static typename DataType::type gather(
+        typename DataType::type value,
+        std::integer_sequence<uint32_t, Indices...>)
+    {
+        uint64_t result = 0;
+
+        int expand[] =
+        {
+            0, (result |= extract_bits(value,
+                    morton::field_bits<Indices, Sizes...>()) <<
+                morton::field_offset<Indices, Sizes...>(), 0)...
+        };
+        (void) expand;
+
+        return static_cast<typename DataType::type>(result);
+    }
+
+    /// Scatters the bits of every field with deposit_bits(...)
+    template<class DataType, uint32_t... Sizes, uint32_t... Indices>
+    static typename DataType::type scatter(
+        typename DataType::type value,
+        std::integer_sequence<uint32_t, Indices...>)
+    {
+        uint64_t result = 0;
+
+        int expand[] =
+        {
+            0, (result |= deposit_bits(
+                    (value >> morton::field_offset<Indices, Sizes...>()) &
+                    field_mask<DataType, Indices, Sizes...>(),
+                    morton::field_bits<Indices, Sizes...>()), 0)...
+        };
+        (void) expand;
+
+        return static_cast<typename DataType::type>(result);
+    }
+};
+
+/// A single field of a value in Morton mode is gathered or scattered on
+/// its own, without touching the other fields
+template<>
+struct field_access<morton>
+{
+    template<class DataType, uint32_t Index, uint32_t... Sizes>
+    static typename DataType::type get(typename DataType::type value)
+    {
+        static_assert(size_in_bits<DataType>() <= 64,
+                      "Morton mode supports values of up to 64 bits");
+
+        return static_cast<typename DataType::type>(
+            extract_bits(value, morton::field_bits<Index, Sizes...>()));
+    }
+
+    template<class DataType, uint32_t Index, uint32_t... Sizes>
+    static typename DataType::type set(typename DataType::type bitfield,
+                                       typename DataType::type value)
+    {
+        static_assert(size_in_bits<DataType>() <= 64,
+                      "Morton mode supports values of up to 64 bits");
+
+        const uint64_t bits = morton::field_bits<Index, Sizes...>();
+
+        return static_cast<typename DataType::type>(
+            (bitfield & ~bits) | deposit_bits(value, bits));
+    }
+};
+}
+}
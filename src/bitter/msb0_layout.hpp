@@ -0,0 +1,14 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "layout.hpp"
+
+namespace bitter
+{
+/// @brief Layout with the fields placed in MSB 0 bit numbering
+template<typename DataType, uint32_t... Sizes>
+using msb0_layout = layout<DataType, msb0, Sizes...>;
+}
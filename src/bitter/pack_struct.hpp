@@ -0,0 +1,164 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/any_field.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bitter
+{
+namespace detail
+{
+template<class Layout, class Struct, uint32_t... Indices>
+typename Layout::value_type pack_struct(
+    const Struct& value, std::integer_sequence<uint32_t, Indices...>)
+{
+    using value_type = typename Layout::value_type;
+
+    auto members = value.tie();
+
+    static_assert(std::tuple_size<decltype(members)>::value ==
+                  Layout::fields,
+                  "The struct must have a member for every field");
+
+    value_type packed = 0;
+
+    int expand[] = { 0, (packed = Layout::template set<Indices>(
+                             packed, static_cast<value_type>(
+                                 std::get<Indices>(members))), 0)...
+                   };
+    (void) expand;
+
+    return packed;
+}
+
+template<class Layout, class Struct, uint32_t... Indices>
+Struct unpack_struct(typename Layout::value_type value,
+                     std::integer_sequence<uint32_t, Indices...>)
+{
+    using value_type = typename Layout::value_type;
+
+    return Struct{ any_field<value_type>{
+            Layout::template get<Indices>(value) }...
+    };
+}
+}
+
+/// @brief Packs the members of a struct into the fields of a layout, the
+///        first member into field 0 etc. The struct lists its members in
+///        a tie() member function:
+///
+///     struct header
+///     {
+///         uint8_t version;
+///         uint16_t length;
+///         bool last;
+///         uint16_t id;
+///
+///         auto tie() const { return std::tie(version, length, last, id); }
+///     };
+///
+///     using wire = bitter::msb0_layout<uint32_t, 4, 11, 1, 16>;
+///     uint32_t packed = bitter::pack_struct<wire>(h);
+///
+/// This is the same as the hand written sequence of set<I>(...) and
+/// compiles to the same code. Members must be integers, bools or enums
+/// fitting their field, and padding fields must be members too.
+/// @return The packed value
+template<class Layout, class Struct>
+typename Layout::value_type pack_struct(const Struct& value)
+{
+    return detail::pack_struct<Layout>(
+        value, std::make_integer_sequence<uint32_t, Layout::fields>());
+}
+
+/// @brief Unpacks the fields of a layout into a struct by aggregate
+///        initialization, the first field initializing the first member
+///        etc. Unlike pack_struct(...) no tie() is needed:
+///
+///     header h = bitter::unpack_struct<wire, header>(packed);
+///
+/// @return The struct holding the fields of value
+template<class Layout, class Struct>
+Struct unpack_struct(typename Layout::value_type value)
+{
+    static_assert(detail::is_initializable<Struct,
+                  std::make_index_sequence<Layout::fields>>::value,
+                  "The struct must be an aggregate with a member for "
+                  "every field");
+    static_assert(!detail::is_initializable<Struct,
+                  std::make_index_sequence<Layout::fields + 1>>::value,
+                  "The struct has more members than the layout has fields");
+
+    return detail::unpack_struct<Layout, Struct>(
+        value, std::make_integer_sequence<uint32_t, Layout::fields>());
+}
+
+/// @brief Packs an array of structs, see pack_struct(...)
+/// @param structs is the structs to pack
+/// @param count is the number of structs
+/// @param values is the count values to write
+template<class Layout, class Struct>
+void pack_structs(const Struct* structs, uint64_t count,
+                  typename Layout::value_type* values)
+{
+    assert((structs != nullptr && values != nullptr) || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        values[i] = pack_struct<Layout>(structs[i]);
+    }
+}
+
+/// @return The packed values of a vector of structs
+template<class Layout, class Struct>
+std::vector<typename Layout::value_type> pack_structs(
+    const std::vector<Struct>& structs)
+{
+    std::vector<typename Layout::value_type> values(structs.size());
+    pack_structs<Layout>(structs.data(), structs.size(), values.data());
+    return values;
+}
+
+/// @brief Unpacks an array of values into structs, see unpack_struct(...)
+/// @param values is the values to unpack
+/// @param count is the number of values
+/// @param structs is the count structs to write
+template<class Layout, class Struct>
+void unpack_structs(const typename Layout::value_type* values,
+                    uint64_t count, Struct* structs)
+{
+    assert((values != nullptr && structs != nullptr) || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        structs[i] = unpack_struct<Layout, Struct>(values[i]);
+    }
+}
+
+/// @return The structs of a vector of packed values
+template<class Layout, class Struct>
+std::vector<Struct> unpack_structs(
+    const std::vector<typename Layout::value_type>& values)
+{
+    std::vector<Struct> structs;
+    structs.reserve(values.size());
+
+    for (auto value : values)
+    {
+        structs.push_back(unpack_struct<Layout, Struct>(value));
+    }
+
+    return structs;
+}
+}
@@ -0,0 +1,234 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/compact_fields.hpp"
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bitter
+{
+namespace detail
+{
+/// The number of bits sorted in each pass of the radix sort
+static constexpr uint32_t radix_bits = 8;
+
+/// The number of buckets of each pass of the radix sort
+static constexpr uint32_t radix_buckets = 1U << radix_bits;
+
+/// @brief Calls function(thread) on the given number of threads, one of
+///        them being the calling thread, and waits for them to finish
+template<class Function>
+void parallel_for(uint32_t threads, Function function)
+{
+    std::vector<std::thread> workers;
+
+    for (uint32_t thread = 1; thread < threads; ++thread)
+    {
+        workers.emplace_back(function, thread);
+    }
+
+    function(0);
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+}
+
+/// @brief Sorts an array of values of a layout by one or more of its
+///        fields using a stable least significant digit radix sort, e.g.
+///        sorting records by the protocol field and then the port field:
+///
+///     using record = bitter::lsb0_layout<uint64_t, 16, 8, 8, 32>;
+///     bitter::radix_sort<record, 2, 0>(records, count, scratch);
+///
+/// The selected fields are packed into a key of just their bits and the
+/// key is sorted 8 bits per pass, so the number of passes depends on the
+/// size of the key fields only. The histograms of all passes are counted
+/// in a single read of the values and passes where all values have the
+/// same digit are skipped.
+/// @param data is the values to sort
+/// @param count is the number of values
+/// @param scratch is a buffer of count values used during the sort, its
+///        content is undefined afterwards
+template<class Layout, uint32_t... KeyFields>
+void radix_sort(typename Layout::value_type* data, uint64_t count,
+                typename Layout::value_type* scratch)
+{
+    using key = detail::compact_fields<Layout, KeyFields...>;
+    using value_type = typename Layout::value_type;
+
+    assert((data != nullptr && scratch != nullptr) || count == 0);
+
+    const uint32_t passes = (key::bits() + detail::radix_bits - 1) /
+                            detail::radix_bits;
+
+    std::vector<uint64_t> histograms(passes * detail::radix_buckets, 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        typename key::packed_type k = key::get(data[i]);
+
+        for (uint32_t pass = 0; pass < passes; ++pass)
+        {
+            uint64_t digit = (k >> (pass * detail::radix_bits)) &
+                             (detail::radix_buckets - 1);
+            ++histograms[pass * detail::radix_buckets + digit];
+        }
+    }
+
+    value_type* from = data;
+    value_type* to = scratch;
+
+    for (uint32_t pass = 0; pass < passes; ++pass)
+    {
+        uint64_t* offsets = histograms.data() + pass * detail::radix_buckets;
+
+        if (std::find(offsets, offsets + detail::radix_buckets, count) !=
+            offsets + detail::radix_buckets)
+        {
+            // All values have the same digit, the pass would not move any
+            continue;
+        }
+
+        uint64_t sum = 0;
+
+        for (uint32_t digit = 0; digit < detail::radix_buckets; ++digit)
+        {
+            uint64_t size = offsets[digit];
+            offsets[digit] = sum;
+            sum += size;
+        }
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            uint64_t digit = (key::get(from[i]) >> (pass * detail::radix_bits)) &
+                             (detail::radix_buckets - 1);
+            to[offsets[digit]++] = from[i];
+        }
+
+        std::swap(from, to);
+    }
+
+    if (from != data)
+    {
+        std::copy(from, from + count, data);
+    }
+}
+
+/// @brief Sorts an array of values of a layout by one or more of its
+///        fields, allocating the scratch buffer internally
+/// @param data is the values to sort
+/// @param count is the number of values
+template<class Layout, uint32_t... KeyFields>
+void radix_sort(typename Layout::value_type* data, uint64_t count)
+{
+    std::vector<typename Layout::value_type> scratch(count);
+    radix_sort<Layout, KeyFields...>(data, count, scratch.data());
+}
+
+/// @brief Sorts an array of values of a layout like radix_sort(...) using
+///        multiple threads. Each thread counts and moves the values of its
+///        part of the array, which keeps the sort stable.
+/// @param data is the values to sort
+/// @param count is the number of values
+/// @param scratch is a buffer of count values used during the sort
+/// @param threads is the number of threads to use, at least one
+template<class Layout, uint32_t... KeyFields>
+void parallel_radix_sort(typename Layout::value_type* data, uint64_t count,
+                         typename Layout::value_type* scratch,
+                         uint32_t threads)
+{
+    using key = detail::compact_fields<Layout, KeyFields...>;
+    using value_type = typename Layout::value_type;
+
+    assert((data != nullptr && scratch != nullptr) || count == 0);
+    assert(threads > 0);
+
+    const uint32_t passes = (key::bits() + detail::radix_bits - 1) /
+                            detail::radix_bits;
+
+    // The offsets of every thread into every bucket
+    std::vector<uint64_t> offsets(threads * detail::radix_buckets);
+
+    value_type* from = data;
+    value_type* to = scratch;
+
+    auto first = [count, threads](uint32_t thread)
+    {
+        return count * thread / threads;
+    };
+
+    for (uint32_t pass = 0; pass < passes; ++pass)
+    {
+        uint32_t shift = pass * detail::radix_bits;
+        std::fill(offsets.begin(), offsets.end(), 0);
+
+        detail::parallel_for(threads, [&](uint32_t thread)
+        {
+            uint64_t* histogram = offsets.data() +
+                                  thread * detail::radix_buckets;
+
+            for (uint64_t i = first(thread); i < first(thread + 1); ++i)
+            {
+                ++histogram[(key::get(from[i]) >> shift) &
+                            (detail::radix_buckets - 1)];
+            }
+        });
+
+        // Turn the counts into offsets, ordered by digit and then thread
+        uint64_t sum = 0;
+        bool trivial = false;
+
+        for (uint32_t digit = 0; digit < detail::radix_buckets; ++digit)
+        {
+            uint64_t start = sum;
+
+            for (uint32_t thread = 0; thread < threads; ++thread)
+            {
+                uint64_t& offset = offsets[thread * detail::radix_buckets +
+                                           digit];
+                uint64_t size = offset;
+                offset = sum;
+                sum += size;
+            }
+
+            trivial = trivial || (sum - start == count);
+        }
+
+        if (trivial)
+        {
+            continue;
+        }
+
+        detail::parallel_for(threads, [&](uint32_t thread)
+        {
+            uint64_t* offset = offsets.data() + thread * detail::radix_buckets;
+
+            for (uint64_t i = first(thread); i < first(thread + 1); ++i)
+            {
+                to[offset[(key::get(from[i]) >> shift) &
+                          (detail::radix_buckets - 1)]++] = from[i];
+            }
+        });
+
+        std::swap(from, to);
+    }
+
+    if (from != data)
+    {
+        std::copy(from, from + count, data);
+    }
+}
+}
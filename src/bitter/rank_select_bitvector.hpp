@@ -0,0 +1,411 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/popcount.hpp"
+#include "detail/select_bit.hpp"
+
+#include "lsb0_reader.hpp"
+#include "lsb0_writer.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <vector>
+
+namespace bitter
+{
+/// @brief Bit vector with constant time rank and fast select queries.
+///
+/// The bits are stored in blocks of 2048 bits each preceded by a single
+/// 64 bit directory entry, so a rank query touches only the cache lines of
+/// the block. The entry holds the rank of the block relative to a top
+/// level counter (one per 2^32 bits) and the cumulative counts of the
+/// first three 512 bit sub blocks:
+///
+///      63        53 52       42 41      32 31                      0
+///     +------------+-----------+----------+-------------------------+
+///     | sub 0..2   | sub 0..1  | sub 0    | rank of block           |
+///     +------------+-----------+----------+-------------------------+
+///
+/// This adds 64 / 2048 = 3.1% to the size of the bits. Select queries use
+/// a sample of the block for every 8192th one (and zero) bit followed by a
+/// binary search over the directory entries and a pdep based select inside
+/// the final word (adding less than 1%).
+///
+/// Everything is stored in a single array of 64 bit words which can be
+/// written to disk and later used directly from memory (e.g. mapped with
+/// mmap) without rebuilding the index.
+class rank_select_bitvector
+{
+public:
+
+    /// The number of bits in a block
+    static constexpr uint64_t block_bits = 2048;
+
+    /// The number of data words in a block
+    static constexpr uint64_t block_words = block_bits / 64;
+
+    /// The number of bits in a sub block
+    static constexpr uint64_t sub_block_bits = 512;
+
+    /// The number of ones (or zeros) between two select samples
+    static constexpr uint64_t sample_rate = 8192;
+
+    /// Value stored first in the data to recognize the format
+    static constexpr uint64_t magic = 0x3130565352544942U;
+
+    /// @brief Builds the bit vector from packed bits
+    /// @param bits is the bits to store. Bit i is the bit (i % 64) (LSB 0
+    ///        numbering) of the word at index i / 64
+    /// @param size is the number of bits
+    rank_select_bitvector(const uint64_t* bits, uint64_t size)
+    {
+        assert(bits != nullptr || size == 0);
+
+        uint64_t blocks = (size + block_bits - 1) / block_bits;
+        uint64_t tops = (size >> 32) + 1;
+
+        std::vector<uint64_t> storage(header_words + blocks * (block_words + 1)
+                                      + tops, 0);
+
+        uint64_t* directory = storage.data() + header_words;
+        uint64_t* top = directory + blocks * (block_words + 1);
+
+        uint64_t ones = 0;
+        std::vector<uint64_t> samples1;
+        std::vector<uint64_t> samples0;
+
+        for (uint64_t block = 0; block < blocks; ++block)
+        {
+            if ((block % blocks_per_top) == 0)
+            {
+                top[block / blocks_per_top] = ones;
+            }
+
+            uint64_t* entry = directory + block * (block_words + 1);
+            uint64_t* words = entry + 1;
+
+            uint64_t relative = ones - top[block / blocks_per_top];
+            uint32_t sub_counts[4] = { 0, 0, 0, 0 };
+
+            for (uint64_t i = 0; i < block_words; ++i)
+            {
+                uint64_t bit = (block * block_words + i) * 64;
+
+                if (bit >= size)
+                {
+                    break;
+                }
+
+                uint64_t word = bits[bit / 64];
+
+                // Clear the bits past the end
+                if (size - bit < 64)
+                {
+                    word &= (uint64_t{1} << (size - bit)) - 1;
+                }
+
+                words[i] = word;
+                sub_counts[i / (sub_block_bits / 64)] += popcount(word);
+            }
+
+            auto writer = lsb0_writer<uint64_t, 32, 10, 11, 11>();
+            writer.field<0>(relative);
+            writer.field<1>(sub_counts[0]);
+            writer.field<2>(sub_counts[0] + sub_counts[1]);
+            writer.field<3>(sub_counts[0] + sub_counts[1] + sub_counts[2]);
+            *entry = writer.data();
+
+            uint64_t block_ones = sub_counts[0] + sub_counts[1] +
+                                  sub_counts[2] + sub_counts[3];
+
+            uint64_t zeros = block * block_bits - ones;
+
+            // Sample the blocks of every sample_rate'th one and zero
+            for (uint64_t k = (ones + sample_rate - 1) / sample_rate;
+                 k * sample_rate < ones + block_ones; ++k)
+            {
+                samples1.push_back(block);
+            }
+
+            for (uint64_t k = (zeros + sample_rate - 1) / sample_rate;
+                 k * sample_rate < zeros + (block_bits - block_ones); ++k)
+            {
+                samples0.push_back(block);
+            }
+
+            ones += block_ones;
+        }
+
+        storage[0] = magic;
+        storage[1] = size;
+        storage[2] = ones;
+        storage[3] = blocks;
+        storage[4] = samples1.size();
+        storage[5] = samples0.size();
+
+        storage.insert(storage.end(), samples1.begin(), samples1.end());
+        storage.insert(storage.end(), samples0.begin(), samples0.end());
+
+        m_storage.swap(storage);
+        m_data = nullptr;
+    }
+
+    /// @brief Uses a bit vector previously built and stored in memory
+    ///        (see data()) without copying it. The memory must stay valid
+    ///        for the lifetime of this object.
+    /// @param data is the words of the bit vector as returned by data()
+    explicit rank_select_bitvector(const uint64_t* data) :
+        m_data(data)
+    {
+        assert(data != nullptr);
+        assert(data[0] == magic && "Not a rank_select_bitvector");
+    }
+
+    /// @return The words holding the bit vector and its index
+    const uint64_t* data() const
+    {
+        return m_data != nullptr ? m_data : m_storage.data();
+    }
+
+    /// @return The number of words returned by data()
+    uint64_t data_words() const
+    {
+        return header_words + blocks() * (block_words + 1) + tops() +
+               data()[4] + data()[5];
+    }
+
+    /// @return The number of bits
+    uint64_t size() const
+    {
+        return data()[1];
+    }
+
+    /// @return The total number of one bits
+    uint64_t count_ones() const
+    {
+        return data()[2];
+    }
+
+    /// @return The bit at position
+    bool get(uint64_t position) const
+    {
+        assert(position < size());
+        return (word(position / 64) >> (position % 64)) & 1U;
+    }
+
+    /// @return The data word at index i.e. the bits 64 * index to
+    ///         64 * index + 63 (LSB 0 numbering)
+    uint64_t word(uint64_t index) const
+    {
+        assert(index < (size() + 63) / 64);
+        return block_entry(index / block_words)[1 + index % block_words];
+    }
+
+    /// @return The number of one bits before position
+    /// @param position is the bit position, at most size()
+    uint64_t rank1(uint64_t position) const
+    {
+        assert(position <= size());
+
+        if (position == size())
+        {
+            return count_ones();
+        }
+
+        uint64_t block = position / block_bits;
+        const uint64_t* entry = block_entry(block);
+
+        uint64_t rank = block_rank(block, *entry);
+        rank += sub_block_rank(*entry, (position / sub_block_bits) % 4);
+
+        // Count the full words of the sub block before the position
+        const uint64_t* words = entry + 1;
+        uint64_t first = ((position % block_bits) / sub_block_bits) *
+                         (sub_block_bits / 64);
+        uint64_t last = (position % block_bits) / 64;
+
+        for (uint64_t i = first; i < last; ++i)
+        {
+            rank += popcount(words[i]);
+        }
+
+        uint64_t mask = (uint64_t{1} << (position % 64)) - 1;
+        return rank + popcount(words[last] & mask);
+    }
+
+    /// @return The number of zero bits before position
+    /// @param position is the bit position, at most size()
+    uint64_t rank0(uint64_t position) const
+    {
+        return position - rank1(position);
+    }
+
+    /// @return The position of the one bit with rank ones before it
+    /// @param rank must be less than count_ones()
+    uint64_t select1(uint64_t rank) const
+    {
+        assert(rank < count_ones());
+        return select<true>(rank);
+    }
+
+    /// @return The position of the zero bit with rank zeros before it
+    /// @param rank must be less than size() - count_ones()
+    uint64_t select0(uint64_t rank) const
+    {
+        assert(rank < size() - count_ones());
+        return select<false>(rank);
+    }
+
+private:
+
+    /// The number of words before the blocks
+    static constexpr uint64_t header_words = 8;
+
+    /// The number of blocks sharing a top level counter
+    static constexpr uint64_t blocks_per_top = (uint64_t{1} << 32) / block_bits;
+
+    /// The layout of a directory entry
+    using entry_reader = lsb0_reader<uint64_t, 32, 10, 11, 11>;
+
+    /// @return The number of blocks
+    uint64_t blocks() const
+    {
+        return data()[3];
+    }
+
+    /// @return The number of top level counters
+    uint64_t tops() const
+    {
+        return (size() >> 32) + 1;
+    }
+
+    /// @return The directory entry of block, followed by its words
+    const uint64_t* block_entry(uint64_t block) const
+    {
+        return data() + header_words + block * (block_words + 1);
+    }
+
+    /// @return The number of ones before the block
+    uint64_t block_rank(uint64_t block, uint64_t entry) const
+    {
+        const uint64_t* top = block_entry(blocks());
+        return top[block / blocks_per_top] +
+               entry_reader(entry).field<0>().as<uint64_t>();
+    }
+
+    /// @return The number of ones in the block before the sub block
+    static uint64_t sub_block_rank(uint64_t entry, uint64_t sub_block)
+    {
+        auto reader = entry_reader(entry);
+
+        switch (sub_block)
+        {
+        case 0:
+            return 0;
+        case 1:
+            return reader.field<1>().as<uint64_t>();
+        case 2:
+            return reader.field<2>().as<uint64_t>();
+        default:
+            return reader.field<3>().as<uint64_t>();
+        }
+    }
+
+    /// @return The number of ones (Bit = true) or zeros before the block
+    template<bool Bit>
+    uint64_t block_count(uint64_t block) const
+    {
+        uint64_t ones = block_rank(block, *block_entry(block));
+        return Bit ? ones : block * block_bits - ones;
+    }
+
+    /// Finds the position of the rank'th one (Bit = true) or zero bit
+    template<bool Bit>
+    uint64_t select(uint64_t rank) const
+    {
+        const uint64_t* samples = block_entry(blocks()) + tops();
+        uint64_t sample_count = data()[4];
+
+        if (!Bit)
+        {
+            samples += sample_count;
+            sample_count = data()[5];
+        }
+
+        // Binary search for the last block with a count <= rank between
+        // the sampled blocks
+        uint64_t sample = rank / sample_rate;
+        assert(sample < sample_count);
+
+        uint64_t low = samples[sample];
+        uint64_t high = sample + 1 < sample_count ?
+                        samples[sample + 1] : blocks() - 1;
+
+        while (low < high)
+        {
+            uint64_t middle = low + (high - low + 1) / 2;
+
+            if (block_count<Bit>(middle) <= rank)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle - 1;
+            }
+        }
+
+        uint64_t block = low;
+        const uint64_t* entry = block_entry(block);
+        rank -= block_count<Bit>(block);
+
+        // Find the sub block using the counts of the directory entry
+        uint64_t sub_block = 3;
+
+        while (sub_block > 0 &&
+               sub_block_count<Bit>(*entry, sub_block) > rank)
+        {
+            --sub_block;
+        }
+
+        rank -= sub_block_count<Bit>(*entry, sub_block);
+
+        // Find the word and the bit within it
+        const uint64_t* words = entry + 1 + sub_block * (sub_block_bits / 64);
+
+        for (uint64_t i = 0;; ++i)
+        {
+            uint64_t value = Bit ? words[i] : ~words[i];
+            uint32_t count = popcount(value);
+
+            if (rank < count)
+            {
+                return block * block_bits + sub_block * sub_block_bits +
+                       i * 64 + select_bit(value, static_cast<uint32_t>(rank));
+            }
+
+            rank -= count;
+        }
+    }
+
+    /// @return The number of ones (Bit = true) or zeros in the block before
+    ///         the sub block
+    template<bool Bit>
+    static uint64_t sub_block_count(uint64_t entry, uint64_t sub_block)
+    {
+        uint64_t ones = sub_block_rank(entry, sub_block);
+        return Bit ? ones : sub_block * sub_block_bits - ones;
+    }
+
+private:
+
+    /// The storage if the bit vector was built by this object
+    std::vector<uint64_t> m_storage;
+
+    /// The external storage if the bit vector was loaded from memory
+    const uint64_t* m_data = nullptr;
+};
+}
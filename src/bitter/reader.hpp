@@ -8,6 +8,8 @@
 #include "detail/sum_sizes.hpp"
 #include "detail/field_get.hpp"
 #include "detail/field_size_in_bits.hpp"
+#include "detail/field_table.hpp"
+#include "detail/max_sizes.hpp"
 #include "detail/bit_field.hpp"
 #include "detail/to_type.hpp"
 
@@ -19,6 +21,8 @@
 #include <vector>
 #include <cassert>
 #include <typeinfo>
+#include <type_traits>
+#include <utility>
 
 namespace bitter
 {
@@ -37,8 +41,15 @@ public:
     using bit_field_type =
         bit_field<typename bitter_type::type, field_size_in_bits<Index, Sizes...>()>;
 
+    /// The bit_field returned when the index is only known at runtime. It
+    /// is sized after the largest field, so it can be read as any type
+    /// that all fields fit into
+    using runtime_bit_field_type =
+        bit_field<typename bitter_type::type, max_sizes<Sizes...>()>;
+
     /// @brief Reader constructor
-    /// DataType must be either u8, u16, u24, u32, u40, u48, u56, or u64
+    /// DataType must be either u8, u16, u24, u32, u40, u48, u56, u64 or
+    /// (if the compiler supports __int128) one of u72 to u128
     reader(typename bitter_type::type value) :
         m_value(value)
     {
@@ -53,7 +64,55 @@ public:
         return bit_field_type<Index>(get<Index>());
     }
 
+    /// @brief Returns the field at an index which is only known at runtime
+    ///
+    /// Example, reading the 8 4-bit lanes of a uint32_t:
+    ///
+    ///     auto reader = bitter::lsb0_reader<uint32_t, 4, 4, 4, 4,
+    ///                                                 4, 4, 4, 4>(value);
+    ///     for (uint32_t i = 0; i < 8; ++i)
+    ///         lanes[i] = reader.field(i).as<uint8_t>();
+    ///
+    runtime_bit_field_type field(uint32_t index) const
+    {
+        assert(index < sizeof...(Sizes));
+        return runtime_bit_field_type(table::get(m_value, index));
+    }
+
+    /// @brief Invokes function once for every field in index order. The
+    ///        loop is unrolled at compile time and the function is called
+    ///        as:
+    ///
+    ///            function(std::integral_constant<uint32_t, Index>(),
+    ///                     field<Index>())
+    ///
+    ///        So a generic lambda can use the index both at compile time
+    ///        and as a plain uint32_t.
+    template<class Function>
+    void for_each_field(Function&& function) const
+    {
+        for_each_field(function,
+                       std::make_integer_sequence<uint32_t, sizeof...(Sizes)>());
+    }
+
 private:
+
+    /// Small alias for the field offset and mask tables
+    using table = field_table<bitter_type, BitNumbering, Sizes...>;
+
+    /// Expands the for_each_field(...) calls for all indices
+    template<class Function, uint32_t... Indices>
+    void for_each_field(Function& function,
+                        std::integer_sequence<uint32_t, Indices...>) const
+    {
+        int expand[] =
+        {
+            0, (function(std::integral_constant<uint32_t, Indices>(),
+                         field<Indices>()), 0)...
+        };
+        (void) expand;
+    }
+
     /// @brief Function used as a wrapper, used for retrieving a field
     ///        based on the Index provide
     template<uint32_t Index>
@@ -0,0 +1,163 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "bit_stream_reader.hpp"
+#include "bit_stream_writer.hpp"
+#include "zigzag.hpp"
+
+#include <cstdint>
+#include <cassert>
+
+namespace bitter
+{
+/// @brief Writes value as a Golomb-Rice code with parameter K. The
+///        quotient value >> K is written in unary as zero bits followed by
+///        a one bit (as in FLAC) and the K low bits of value follow.
+template<class BitNumbering>
+void rice_encode(bit_stream_writer<BitNumbering>& writer, uint64_t value,
+                 uint32_t k)
+{
+    assert(k < 64);
+
+    uint64_t quotient = value >> k;
+
+    while (quotient >= 56)
+    {
+        writer.write(0, 56);
+        quotient -= 56;
+    }
+
+    writer.write(0, static_cast<uint32_t>(quotient));
+    writer.write(1, 1);
+    writer.write(k ? value & ((uint64_t{1} << k) - 1) : 0, k);
+}
+
+/// @brief Reads a Golomb-Rice code with parameter K written with
+///        rice_encode(...)
+/// @return The value, or zero if the data ended or the quotient does not
+///         fit in 64 bits, which makes the reader invalid
+template<class BitNumbering>
+uint64_t rice_decode(bit_stream_reader<BitNumbering>& reader, uint32_t k)
+{
+    assert(k < 64);
+
+    const uint64_t max_quotient = ~uint64_t{0} >> k;
+    uint64_t quotient = 0;
+
+    while (true)
+    {
+        if (reader.buffered_bits() < bit_stream_reader<BitNumbering>::refill_bits)
+        {
+            reader.refill();
+        }
+
+        // The unary quotient is counted with a single lzcnt/tzcnt
+        uint32_t zeros = reader.count_zeros();
+        quotient += zeros;
+
+        if (reader.buffered_bits() == 0 || quotient > max_quotient)
+        {
+            // The data ended within the quotient or the code is invalid
+            reader.fail();
+            return 0;
+        }
+
+        if (zeros < reader.buffered_bits())
+        {
+            reader.consume(zeros + 1);
+            break;
+        }
+
+        reader.consume(zeros);
+    }
+
+    return (quotient << k) | reader.read(k);
+}
+
+/// @brief Writes a signed value as a zigzag mapped Golomb-Rice code
+template<class BitNumbering>
+void rice_encode_signed(bit_stream_writer<BitNumbering>& writer,
+                        int64_t value, uint32_t k)
+{
+    rice_encode(writer, zigzag_encode(value), k);
+}
+
+/// @brief Reads a signed Golomb-Rice code written with
+///        rice_encode_signed(...)
+template<class BitNumbering>
+int64_t rice_decode_signed(bit_stream_reader<BitNumbering>& reader,
+                           uint32_t k)
+{
+    return zigzag_decode(rice_decode(reader, k));
+}
+
+/// @brief Writes an array of values as Golomb-Rice codes with parameter K
+template<class BitNumbering>
+void rice_encode(bit_stream_writer<BitNumbering>& writer,
+                 const uint64_t* values, uint64_t count, uint32_t k)
+{
+    assert(values != nullptr || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        rice_encode(writer, values[i], k);
+    }
+}
+
+/// @brief Reads an array of Golomb-Rice codes with parameter K. As long as
+///        codes are short several are decoded from the bit buffer before it
+///        is refilled.
+/// @return The number of values decoded, less than count if the data
+///         ended or held an invalid code
+template<class BitNumbering>
+uint64_t rice_decode(bit_stream_reader<BitNumbering>& reader, uint64_t* values,
+                 uint64_t count, uint32_t k)
+{
+    assert(values != nullptr || count == 0);
+    assert(k < 64);
+
+    uint64_t i = 0;
+
+    while (i < count)
+    {
+        reader.refill();
+
+        // Decode while the next code is known to be fully buffered
+        while (i < count)
+        {
+            uint32_t zeros = reader.count_zeros();
+
+            if (zeros + 1 + k > reader.buffered_bits() ||
+                k > reader.refill_bits)
+            {
+                break;
+            }
+
+            reader.consume(zeros + 1);
+
+            uint64_t rest = k ? reader.peek(k) : 0;
+            reader.consume(k);
+
+            values[i++] = (static_cast<uint64_t>(zeros) << k) | rest;
+        }
+
+        // Codes not fully buffered take the general path
+        if (i < count)
+        {
+            values[i] = rice_decode(reader, k);
+
+            if (!reader.is_valid())
+            {
+                return i;
+            }
+
+            ++i;
+        }
+    }
+
+    return i;
+}
+}
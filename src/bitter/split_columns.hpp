@@ -0,0 +1,85 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace bitter
+{
+namespace detail
+{
+/// @brief Writes the field at Index of count values to output
+template<class Layout, uint32_t Index, class Output>
+void split_column(const typename Layout::value_type* data, uint64_t count,
+                  Output* output)
+{
+    static_assert(sizeof(Output) * 8 >= Layout::template field_size<Index>(),
+                  "The output type is too small for the field");
+
+    assert(output != nullptr || count == 0);
+
+    // With the offset and mask known at compile time this is a plain
+    // shift/mask/convert loop which the compiler vectorizes
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        output[i] = static_cast<Output>(Layout::template get<Index>(data[i]));
+    }
+}
+
+template<class Layout, uint32_t... Indices, class... Outputs>
+void split_columns(std::integer_sequence<uint32_t, Indices...>,
+                   const typename Layout::value_type* data, uint64_t count,
+                   Outputs*... outputs)
+{
+    int expand[] = { 0, (split_column<Layout, Indices>(
+                             data, count, outputs), 0)...
+                   };
+    (void) expand;
+}
+}
+
+/// @brief Splits an array of values of a layout into one array per field
+///        (array of structures to structure of arrays).
+///
+/// The type of each output array is chosen by the caller, e.g.:
+///
+///     using header = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+///     std::vector<uint8_t> version(count);
+///     std::vector<uint16_t> length(count);
+///     std::vector<uint16_t> id(count);
+///
+///     bitter::split_columns<header>(headers, count, version.data(),
+///                                   length.data(), id.data());
+///
+/// The values are processed in chunks which stay in the L1 cache while
+/// every field of the chunk is written.
+/// @param data is the values of the layout
+/// @param count is the number of values
+/// @param outputs is one array of count elements per field
+template<class Layout, class... Outputs>
+void split_columns(const typename Layout::value_type* data, uint64_t count,
+                   Outputs*... outputs)
+{
+    static_assert(sizeof...(Outputs) == Layout::fields,
+                  "There must be an output for every field");
+
+    assert(data != nullptr || count == 0);
+
+    const uint64_t chunk = 1024;
+
+    for (uint64_t first = 0; first < count; first += chunk)
+    {
+        detail::split_columns<Layout>(
+            std::make_integer_sequence<uint32_t, Layout::fields>(),
+            data + first, std::min(chunk, count - first),
+            (outputs + first)...);
+    }
+}
+}
@@ -0,0 +1,176 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/load_layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+
+namespace bitter
+{
+/// @brief Decoder for a stream of packed records of a layout arriving in
+///        chunks of any size, e.g. from a socket. Records within a chunk
+///        are decoded in place; only a record straddling the end of a
+///        chunk is copied into a small buffer and completed by the next
+///        chunk.
+///
+/// Records can be pushed to a function:
+///
+///     bitter::stream_decoder<record> decoder;
+///
+///     while (uint64_t size = receive(buffer))
+///     {
+///         decoder.feed(buffer, size, [](record::value_type value)
+///         {
+///             ...
+///         });
+///     }
+///
+/// or pulled one at a time, e.g. from a generator or state machine that
+/// resumes where it left off:
+///
+///     decoder.feed(buffer, size);
+///     record::value_type value;
+///
+///     while (decoder.next(value))
+///     {
+///         ...
+///     }
+///
+/// The bytes of a record are in big endian byte order if the layout uses
+/// msb0 and in little endian byte order if it uses lsb0.
+template<class Layout>
+class stream_decoder
+{
+public:
+
+    /// The integer type holding a record
+    using value_type = typename Layout::value_type;
+
+    /// The size of a record in bytes
+    static constexpr uint32_t record_size = Layout::bitter_type::size;
+
+    /// @brief Sets the next chunk of the stream. Records are decoded from
+    ///        it by next(...), so it must stay valid until next(...)
+    ///        returns false. The bytes of the previous chunk must all
+    ///        have been consumed.
+    /// @param data is the chunk
+    /// @param size is the size of the chunk in bytes
+    void feed(const uint8_t* data, uint64_t size)
+    {
+        assert(data != nullptr || size == 0);
+        assert(m_data == m_end && "The previous chunk is not consumed");
+
+        m_data = data;
+        m_end = data + size;
+    }
+
+    /// @brief Feeds a chunk and invokes function(value) for every record
+    ///        completed by it
+    /// @param data is the chunk, it is not used after the call returns
+    /// @param size is the size of the chunk in bytes
+    /// @param function is invoked with every completed record
+    /// @return The number of records completed by the chunk
+    template<class Function>
+    uint64_t feed(const uint8_t* data, uint64_t size, Function&& function)
+    {
+        feed(data, size);
+
+        uint64_t count = 0;
+        value_type value;
+
+        while (next(value))
+        {
+            function(value);
+            ++count;
+        }
+
+        return count;
+    }
+
+    /// @brief Decodes the next record of the stream
+    /// @param value is set to the record if a complete record is available
+    /// @return True if a record was decoded, false if the chunk is
+    ///         consumed (its remaining bytes are kept for the next chunk)
+    bool next(value_type& value)
+    {
+        uint64_t available = static_cast<uint64_t>(m_end - m_data);
+
+        if (available == 0)
+        {
+            return false;
+        }
+
+        if (m_pending > 0)
+        {
+            // Complete the record started in the previous chunks
+            uint32_t missing = record_size - m_pending;
+            uint32_t bytes = static_cast<uint32_t>(
+                std::min<uint64_t>(missing, available));
+
+            std::memcpy(m_partial + m_pending, m_data, bytes);
+            m_pending += bytes;
+            m_data += bytes;
+
+            if (m_pending < record_size)
+            {
+                return false;
+            }
+
+            value = load_layout<Layout>(m_partial);
+            m_pending = 0;
+            return true;
+        }
+
+        if (available >= record_size)
+        {
+            value = load_layout<Layout>(m_data);
+            m_data += record_size;
+            return true;
+        }
+
+        // Keep the start of a record straddling the end of the chunk
+        std::memcpy(m_partial, m_data, available);
+        m_pending = static_cast<uint32_t>(available);
+        m_data = m_end;
+
+        return false;
+    }
+
+    /// @return The number of bytes of an incomplete record carried over
+    ///         to the next chunk
+    uint32_t pending() const
+    {
+        return m_pending;
+    }
+
+    /// @brief Drops an incomplete record, e.g. when the stream is reset
+    void reset()
+    {
+        m_pending = 0;
+        m_data = m_end;
+    }
+
+private:
+
+    /// The next byte of the current chunk
+    const uint8_t* m_data = nullptr;
+
+    /// The end of the current chunk
+    const uint8_t* m_end = nullptr;
+
+    /// The bytes of a record straddling chunks
+    uint8_t m_partial[record_size];
+
+    /// The number of bytes in m_partial
+    uint32_t m_pending = 0;
+};
+
+template<class Layout>
+constexpr uint32_t stream_decoder<Layout>::record_size;
+}
@@ -0,0 +1,236 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/lane_masks.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <utility>
+
+namespace bitter
+{
+/// @brief Arithmetic on all fields of a value at once (SIMD within a
+///        register). Each field of the layout is an unsigned lane and no
+///        carries or borrows leak between the lanes, e.g. for 8 8-bit
+///        counters in a uint64_t:
+///
+///     using counters = bitter::swar<bitter::lsb0_layout<uint64_t,
+///                                   8, 8, 8, 8, 8, 8, 8, 8>>;
+///
+///     value = counters::add_saturate(value, counters::broadcast(1));
+///
+/// The fields do not need to have the same size. The operations work on
+/// the low bits of every lane and handle the most significant bit of each
+/// lane separately using masks computed at compile time, so the cost does
+/// not depend on the number of lanes. Results of comparisons are lane
+/// masks, i.e. all bits of a lane are set if the comparison is true.
+/// The lanes are computed in a uint64_t, so layouts of up to 64 bits are
+/// supported.
+template<class Layout>
+struct swar
+{
+    static_assert(Layout::bits <= 64,
+                  "SWAR operations support layouts of up to 64 bits");
+
+    /// The type of the values
+    using value_type = typename Layout::value_type;
+
+    /// @return The lanes of a plus the lanes of b modulo the lane sizes
+    static value_type add(value_type a, value_type b)
+    {
+        return static_cast<value_type>(add_lanes(a, b));
+    }
+
+    /// @return The lanes of a minus the lanes of b modulo the lane sizes
+    static value_type sub(value_type a, value_type b)
+    {
+        return static_cast<value_type>(sub_lanes(a, b));
+    }
+
+    /// @return The lanes of a plus the lanes of b, limited to the maximum
+    ///         value of each lane
+    static value_type add_saturate(value_type a, value_type b)
+    {
+        uint64_t x = a;
+        uint64_t y = b;
+        uint64_t sum = add_lanes(x, y);
+
+        // The carry out of the top bit of each lane
+        uint64_t carry = ((x & y) | ((x | y) & ~sum)) & masks::top();
+        return static_cast<value_type>(sum | fill(carry));
+    }
+
+    /// @return The lanes of a minus the lanes of b, limited to zero
+    static value_type sub_saturate(value_type a, value_type b)
+    {
+        uint64_t x = a;
+        uint64_t y = b;
+        uint64_t difference = sub_lanes(x, y);
+
+        return static_cast<value_type>(difference & ~fill(borrow(
+                                           x, y, difference)));
+    }
+
+    /// @return The lanes of value plus one modulo the lane sizes
+    static value_type increment(value_type value)
+    {
+        return static_cast<value_type>(add_lanes(value, masks::bottom()));
+    }
+
+    /// @return A lane mask of the lanes where a equals b
+    static value_type compare_eq(value_type a, value_type b)
+    {
+        uint64_t x = uint64_t(a ^ b);
+
+        // The top bit of each lane is set if any bit of the lane is set
+        uint64_t any = (((x & masks::low()) + masks::low()) | x) &
+                       masks::top();
+
+        return static_cast<value_type>(~fill(any) & masks::all());
+    }
+
+    /// @return A lane mask of the lanes where a is less than b
+    static value_type compare_lt(value_type a, value_type b)
+    {
+        uint64_t x = a;
+        uint64_t y = b;
+
+        return static_cast<value_type>(fill(borrow(x, y, sub_lanes(x, y))));
+    }
+
+    /// @return A lane mask of the lanes where a is less than or equal to b
+    static value_type compare_le(value_type a, value_type b)
+    {
+        return static_cast<value_type>(~compare_lt(b, a) & masks::all());
+    }
+
+    /// @return The lane wise minimum of a and b
+    static value_type min(value_type a, value_type b)
+    {
+        value_type less = compare_lt(a, b);
+        return static_cast<value_type>((a & less) | (b & ~less));
+    }
+
+    /// @return The lane wise maximum of a and b
+    static value_type max(value_type a, value_type b)
+    {
+        value_type less = compare_lt(a, b);
+        return static_cast<value_type>((b & less) | (a & ~less));
+    }
+
+    /// @return The sum of all lanes
+    static uint64_t horizontal_sum(value_type value)
+    {
+        return horizontal_sum(uint64_t(value), is_foldable());
+    }
+
+    /// @return A value with every lane set to lane
+    /// @param lane must fit in every lane
+    static value_type broadcast(uint64_t lane)
+    {
+        uint64_t value = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            assert(lane <= Layout::table::masks[i] &&
+                   "value exceeds limit representable by available bits");
+
+            value |= lane << Layout::table::offsets[i];
+        }
+
+        return static_cast<value_type>(value);
+    }
+
+private:
+
+    using masks = detail::lane_masks<Layout>;
+
+    /// Lanes of the same power of two size and count can be summed by
+    /// repeatedly adding neighbouring lanes
+    using is_foldable = std::integral_constant<bool,
+          Layout::table::is_uniform() &&
+          (Layout::fields & (Layout::fields - 1)) == 0>;
+
+    static uint64_t add_lanes(uint64_t a, uint64_t b)
+    {
+        // Add the low bits of the lanes, the carries stop at the top bits,
+        // then add the top bits without carry
+        return ((a & masks::low()) + (b & masks::low())) ^
+               ((a ^ b) & masks::top());
+    }
+
+    static uint64_t sub_lanes(uint64_t a, uint64_t b)
+    {
+        // Set the top bits of a so the borrows stop there
+        return ((a | masks::top()) - (b & masks::low())) ^
+               ((a ^ ~b) & masks::top());
+    }
+
+    /// @return The borrow out of the top bit of each lane of a - b
+    static uint64_t borrow(uint64_t a, uint64_t b, uint64_t difference)
+    {
+        return ((~a & b) | ((~a | b) & difference)) & masks::top();
+    }
+
+    template<uint32_t... Sizes>
+    static uint64_t fill(uint64_t top, std::integer_sequence<uint32_t, Sizes...>)
+    {
+        // Move the top bit of each lane to its bottom bit, one shift per
+        // different lane size
+        uint64_t bottom = 0;
+
+        int expand[] = { 0, (bottom |= (top & masks::size_top(Sizes)) >>
+                             (masks::size(Sizes) - 1), 0)...
+                       };
+        (void) expand;
+
+        return (top - bottom) | top;
+    }
+
+    /// @return The lanes with the top bit set in top filled with ones
+    static uint64_t fill(uint64_t top)
+    {
+        return fill(top, std::make_integer_sequence<uint32_t, masks::sizes()>());
+    }
+
+    static uint64_t horizontal_sum(uint64_t value, std::true_type)
+    {
+        // Add neighbouring lanes into lanes of twice the size until a
+        // single lane is left. The sum of two lanes always fits in the
+        // double sized lane.
+        uint32_t size = Layout::table::sizes[0];
+
+        for (uint32_t lanes = Layout::fields; lanes > 1; lanes /= 2)
+        {
+            uint64_t mask = 0;
+
+            for (uint32_t i = 0; i < lanes; i += 2)
+            {
+                mask |= ((uint64_t{1} << size) - 1) << (i * size);
+            }
+
+            value = (value & mask) + ((value >> size) & mask);
+            size *= 2;
+        }
+
+        return value;
+    }
+
+    static uint64_t horizontal_sum(uint64_t value, std::false_type)
+    {
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            sum += Layout::table::get(static_cast<value_type>(value), i);
+        }
+
+        return sum;
+    }
+};
+}
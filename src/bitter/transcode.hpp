@@ -0,0 +1,114 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "detail/transcode_plan.hpp"
+
+#include "layout.hpp"
+
+#include <cstdint>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+namespace bitter
+{
+/// @brief The mapping of a transcode(...), entry i is the index of the
+///        source field written to field i of the target layout (or
+///        no_field to write zero)
+template<uint32_t... Indices>
+using field_map = std::integer_sequence<uint32_t, Indices...>;
+
+namespace detail
+{
+template<int32_t Distance>
+uint64_t shift(uint64_t value, std::true_type)
+{
+    return value << Distance;
+}
+
+template<int32_t Distance>
+uint64_t shift(uint64_t value, std::false_type)
+{
+    return value >> -Distance;
+}
+
+template<class Plan, uint32_t... Groups>
+uint64_t transcode(uint64_t value, std::integer_sequence<uint32_t, Groups...>)
+{
+    uint64_t result = 0;
+
+    int expand[] = { 0, (result |= shift<Plan::group_distance(Groups)>(
+                             value & Plan::group_mask(Groups),
+                             std::integral_constant<bool,
+                             (Plan::group_distance(Groups) >= 0)>()), 0)...
+                   };
+    (void) expand;
+
+    return result;
+}
+
+template<class From, class To, class Mapping>
+struct transcoder;
+
+template<class From, class To, uint32_t... Map>
+struct transcoder<From, To, field_map<Map...>>
+{
+    using plan = transcode_plan<From, To, Map...>;
+
+    static typename To::value_type transcode(typename From::value_type value)
+    {
+        // Every mapped field must fit in the target field
+        for (uint32_t i = 0; i < To::fields; ++i)
+        {
+            assert(!plan::is_mapped(i) ||
+                   From::table::get(value, plan::source(i)) <=
+                   To::table::mask(i));
+        }
+
+        return static_cast<typename To::value_type>(detail::transcode<plan>(
+            value, std::make_integer_sequence<uint32_t, plan::groups()>()));
+    }
+};
+}
+
+/// @brief Converts a value of one layout to another, e.g. from an internal
+///        LSB 0 layout to a MSB 0 wire format with the fields in another
+///        order:
+///
+///     using internal = bitter::lsb0_layout<uint32_t, 8, 8, 16>;
+///     using wire = bitter::msb0_layout<uint32_t, 16, 8, 8>;
+///
+///     // wire field 0 is internal field 2 etc.
+///     using mapping = bitter::field_map<2, 0, 1>;
+///
+///     uint32_t out = bitter::transcode<internal, wire, mapping>(in);
+///
+/// The shifts and masks are computed at compile time and fields moved by
+/// the same distance share a single shift and mask. A mapped field must
+/// fit in the target field, and target fields mapped to no_field are zero.
+template<class From, class To, class Mapping>
+typename To::value_type transcode(typename From::value_type value)
+{
+    return detail::transcoder<From, To, Mapping>::transcode(value);
+}
+
+/// @brief Converts an array of values of one layout to another
+/// @param input is the values to convert
+/// @param count is the number of values
+/// @param output is the array of count values to write
+template<class From, class To, class Mapping>
+void transcode(const typename From::value_type* input, uint64_t count,
+               typename To::value_type* output)
+{
+    assert(input != nullptr || count == 0);
+    assert(output != nullptr || count == 0);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        output[i] = transcode<From, To, Mapping>(input[i]);
+    }
+}
+}
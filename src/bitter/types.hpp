@@ -48,4 +48,51 @@ struct u64
     using type = uint64_t;
     static constexpr uint32_t size = 8;
 };
+
+#if defined(__SIZEOF_INT128__)
+/// The unsigned 128 bit integer used for the types above 64 bits. The
+/// __extension__ keeps pedantic builds from warning about __int128.
+__extension__ typedef unsigned __int128 uint128_t;
+
+struct u72
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 9;
+};
+struct u80
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 10;
+};
+struct u88
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 11;
+};
+struct u96
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 12;
+};
+struct u104
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 13;
+};
+struct u112
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 14;
+};
+struct u120
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 15;
+};
+struct u128
+{
+    using type = uint128_t;
+    static constexpr uint32_t size = 16;
+};
+#endif
 }
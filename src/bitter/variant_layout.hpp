@@ -0,0 +1,408 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include "layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace bitter
+{
+/// @brief The field of a layout holding the tag of a variant_layout
+template<class Layout, uint32_t Index>
+struct tag_field
+{
+    /// The layout holding the tag
+    using layout = Layout;
+
+    /// The integer type holding a value
+    using value_type = typename Layout::value_type;
+
+    /// The index of the tag field in the layout
+    static constexpr uint32_t index = Index;
+
+    /// The number of bits of the tag
+    static constexpr uint32_t size = Layout::template field_size<Index>();
+
+    /// @return The tag of value
+    static uint32_t get(value_type value)
+    {
+        return static_cast<uint32_t>(Layout::template get<Index>(value));
+    }
+};
+
+template<class Layout, uint32_t Index>
+constexpr uint32_t tag_field<Layout, Index>::index;
+
+template<class Layout, uint32_t Index>
+constexpr uint32_t tag_field<Layout, Index>::size;
+
+/// @brief A layout of a variant_layout selected by the tag value Tag
+template<uint32_t Tag, class Layout>
+struct variant_case
+{
+    /// The tag selecting the layout
+    static constexpr uint32_t tag = Tag;
+
+    /// The layout
+    using layout = Layout;
+};
+
+template<uint32_t Tag, class Layout>
+constexpr uint32_t variant_case<Tag, Layout>::tag;
+
+namespace detail
+{
+/// The tag and layout of the case at Index of a variant_layout, a plain
+/// layout is selected by the tag equal to its index
+template<uint32_t Index, class Case>
+struct variant_case_traits
+{
+    static constexpr uint32_t tag = Index;
+    using layout = Case;
+};
+
+template<uint32_t Index, uint32_t Tag, class Layout>
+struct variant_case_traits<Index, variant_case<Tag, Layout>>
+{
+    static constexpr uint32_t tag = Tag;
+    using layout = Layout;
+};
+
+template<class Indices, class... Cases>
+struct variant_cases;
+
+/// The tags and layouts of the cases of a variant_layout
+template<uint32_t... Indices, class... Cases>
+struct variant_cases<std::integer_sequence<uint32_t, Indices...>, Cases...>
+{
+    /// The number of cases
+    static constexpr uint32_t count = sizeof...(Cases);
+
+    /// The tag of every case
+    static constexpr uint32_t tags[] =
+    {
+        variant_case_traits<Indices, Cases>::tag...
+    };
+
+    /// The layout of every case
+    using layouts =
+        std::tuple<typename variant_case_traits<Indices, Cases>::layout...>;
+
+    /// @return The index of the case with the tag, count if there is none
+    static constexpr uint32_t find(uint32_t tag)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (tags[i] == tag)
+            {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    /// @return True if no two cases have the same tag
+    static constexpr bool is_unique()
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (find(tags[i]) != i)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @return The largest tag
+    static constexpr uint32_t max_tag()
+    {
+        uint32_t max = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            max = tags[i] > max ? tags[i] : max;
+        }
+        return max;
+    }
+};
+
+template<uint32_t... Indices, class... Cases>
+constexpr uint32_t variant_cases<
+    std::integer_sequence<uint32_t, Indices...>, Cases...>::count;
+
+template<uint32_t... Indices, class... Cases>
+constexpr uint32_t variant_cases<
+    std::integer_sequence<uint32_t, Indices...>, Cases...>::tags[];
+}
+
+/// @brief A value which is one of several layouts, selected by a tag field
+///        (e.g. a version or type field) shared by all of them. A layout
+///        given as variant_case<Tag, Layout> applies to values with the
+///        tag Tag, e.g. for the 4 bit IP version:
+///
+///     using tag = bitter::tag_field<bitter::msb0_layout<uint32_t, 4, 28>, 0>;
+///     using ip = bitter::variant_layout<tag,
+///         bitter::variant_case<4, ipv4_word>,
+///         bitter::variant_case<6, ipv6_word>>;
+///
+///     ip::visit(value, [](auto tag, auto reader)
+///     {
+///         // tag is a std::integral_constant with the tag and reader
+///         // the reader of the layout of that tag
+///     });
+///
+/// A plain layout at index i applies to values with the tag i. The tag
+/// is decoded once and dispatched through a table of functions with an
+/// entry for every value of the tag field, generated at compile time, so
+/// the dispatch is a single indirect call also for sparse tags.
+template<class TagField, class... Cases>
+struct variant_layout
+{
+private:
+
+    /// The tags and layouts of the cases
+    using cases = detail::variant_cases<
+        std::make_integer_sequence<uint32_t, sizeof...(Cases)>, Cases...>;
+
+public:
+
+    /// The integer type holding a value
+    using value_type = typename TagField::value_type;
+
+    /// The layout at Index
+    template<uint32_t Index>
+    using layout_type =
+        typename std::tuple_element<Index, typename cases::layouts>::type;
+
+    /// The number of layouts
+    static constexpr uint32_t layouts = sizeof...(Cases);
+
+    /// The number of values of the tag field
+    static constexpr uint32_t tags = 1U << TagField::size;
+
+    static_assert(layouts > 0, "A variant layout needs at least one layout");
+    static_assert(TagField::size <= 8,
+                  "The jump table supports tag fields of up to 8 bits");
+    static_assert(cases::is_unique(), "Every layout needs its own tag");
+    static_assert(cases::max_tag() < tags,
+                  "The tags must be values of the tag field");
+
+    /// @return The tag selecting the layout at Index
+    template<uint32_t Index>
+    static constexpr uint32_t case_tag()
+    {
+        return cases::tags[Index];
+    }
+
+    /// @return The tag of value, which is not necessarily valid
+    static uint32_t tag(value_type value)
+    {
+        return TagField::get(value);
+    }
+
+    /// @return True if the tag of value selects one of the layouts
+    static bool is_valid(value_type value)
+    {
+        return group(value) < layouts;
+    }
+
+    /// @brief Invokes the visitor with the reader of the layout selected by
+    ///        the tag of value:
+    ///
+    ///            visitor(std::integral_constant<uint32_t, Tag>(),
+    ///                    layout::reader_type(value))
+    ///
+    /// @return True if the visitor was invoked, false if the tag is not
+    ///         valid
+    template<class Visitor>
+    static bool visit(value_type value, Visitor&& visitor)
+    {
+        return jump_table<Visitor>(
+            std::make_integer_sequence<uint32_t, tags>())[tag(value)](
+                visitor, value);
+    }
+
+    /// @brief Partitions an array of values by their tags, keeping the
+    ///        order of the values within each group
+    /// @param values is the values to partition
+    /// @param count is the number of values
+    /// @param output is a buffer of count values receiving the values
+    ///        grouped by layout in the order of the layouts, followed by
+    ///        the values with invalid tags
+    /// @param offsets is a buffer of layouts + 2 offsets receiving the
+    ///        start of the group of every layout in output, the start of
+    ///        the invalid values and count
+    static void partition(const value_type* values, uint64_t count,
+                          value_type* output, uint64_t* offsets)
+    {
+        assert((values != nullptr && output != nullptr) || count == 0);
+        assert(offsets != nullptr);
+
+        uint64_t sizes[layouts + 1] = { };
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            ++sizes[group(values[i])];
+        }
+
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i <= layouts; ++i)
+        {
+            offsets[i] = sum;
+            sum += sizes[i];
+        }
+
+        offsets[layouts + 1] = sum;
+
+        uint64_t next[layouts + 1];
+        std::copy(offsets, offsets + layouts + 1, next);
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            output[next[group(values[i])]++] = values[i];
+        }
+    }
+
+    /// @brief Invokes the visitor for every value with a valid tag. The
+    ///        values are first partitioned by tag and every group is then
+    ///        decoded by its own loop, so there is no dispatch per value.
+    ///        The values of a group are visited in their original order.
+    /// @param values is the values to visit
+    /// @param count is the number of values
+    /// @param scratch is a buffer of count values used for partitioning
+    /// @param visitor is invoked as in visit(value, visitor)
+    /// @return The number of values with an invalid tag, which are skipped
+    template<class Visitor>
+    static uint64_t visit(const value_type* values, uint64_t count,
+                          value_type* scratch, Visitor&& visitor)
+    {
+        uint64_t offsets[layouts + 2];
+        partition(values, count, scratch, offsets);
+
+        visit_groups(scratch, offsets, visitor,
+                     std::make_integer_sequence<uint32_t, layouts>());
+
+        return offsets[layouts + 1] - offsets[layouts];
+    }
+
+private:
+
+    /// @return The index of the layout of value, layouts if the tag is
+    ///         not valid
+    static uint32_t group(value_type value)
+    {
+        return group_table(std::make_integer_sequence<uint32_t, tags>())[
+            tag(value)];
+    }
+
+    /// @return The table with the index of the layout of every tag
+    template<uint32_t... Tags>
+    static const uint8_t* group_table(std::integer_sequence<uint32_t, Tags...>)
+    {
+        static_assert(layouts < 256, "Too many layouts");
+
+        static const uint8_t table[] =
+        {
+            static_cast<uint8_t>(cases::find(Tags))...
+        };
+
+        return table;
+    }
+
+    /// The function invoking a visitor with the reader of a layout
+    template<class Visitor>
+    using call_type = bool (*)(Visitor&, value_type);
+
+    /// @return The table with the function for every tag
+    template<class Visitor, uint32_t... Tags>
+    static const call_type<Visitor>* jump_table(
+        std::integer_sequence<uint32_t, Tags...>)
+    {
+        static const call_type<Visitor> table[] =
+        {
+            &call<Visitor, Tags>...
+        };
+
+        return table;
+    }
+
+    /// Invokes the visitor with the reader of the layout of Tag
+    /// @return False if no layout has the tag
+    template<class Visitor, uint32_t Tag>
+    static bool call(Visitor& visitor, value_type value)
+    {
+        return call_case<Tag, cases::find(Tag)>(
+                   visitor, value,
+                   std::integral_constant<bool, (cases::find(Tag) < layouts)>());
+    }
+
+    template<uint32_t Tag, uint32_t Index, class Visitor>
+    static bool call_case(Visitor& visitor, value_type value, std::true_type)
+    {
+        static_assert(std::is_same<typename layout_type<Index>::value_type,
+                                   value_type>::value,
+                      "All layouts must use the value type of the tag");
+
+        visitor(std::integral_constant<uint32_t, Tag>(),
+                typename layout_type<Index>::reader_type(value));
+
+        return true;
+    }
+
+    template<uint32_t Tag, uint32_t Index, class Visitor>
+    static bool call_case(Visitor&, value_type, std::false_type)
+    {
+        return false;
+    }
+
+    /// Expands the loops over every group
+    template<class Visitor, uint32_t... Indices>
+    static void visit_groups(const value_type* values,
+                             const uint64_t* offsets, Visitor& visitor,
+                             std::integer_sequence<uint32_t, Indices...>)
+    {
+        int expand[] =
+        {
+            0, (visit_group<Indices>(values + offsets[Indices],
+                                     offsets[Indices + 1] - offsets[Indices],
+                                     visitor), 0)...
+        };
+        (void) expand;
+    }
+
+    /// Visits the values of the group of the layout at Index
+    template<uint32_t Index, class Visitor>
+    static void visit_group(const value_type* values, uint64_t count,
+                            Visitor& visitor)
+    {
+        static_assert(std::is_same<typename layout_type<Index>::value_type,
+                                   value_type>::value,
+                      "All layouts must use the value type of the tag");
+
+        using reader_type = typename layout_type<Index>::reader_type;
+        using tag_type = std::integral_constant<uint32_t,
+              cases::tags[Index]>;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            visitor(tag_type(), reader_type(values[i]));
+        }
+    }
+};
+
+template<class TagField, class... Cases>
+constexpr uint32_t variant_layout<TagField, Cases...>::layouts;
+
+template<class TagField, class... Cases>
+constexpr uint32_t variant_layout<TagField, Cases...>::tags;
+}
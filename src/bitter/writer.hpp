@@ -8,6 +8,7 @@
 #include "detail/sum_sizes.hpp"
 #include "detail/field_size_in_bits.hpp"
 #include "detail/field_set.hpp"
+#include "detail/field_table.hpp"
 #include "detail/to_type.hpp"
 
 #include "lsb0.hpp"
@@ -57,6 +58,18 @@ public:
                  bitter_type, BitNumbering, Index, Sizes...>(m_data, value);
     }
 
+    /// @brief Writes the value to the field at an index which is only
+    ///        known at runtime
+    /// @param index is the index of the field
+    /// @param value is the data, wished to written to the field at index
+    void field(uint32_t index, typename bitter_type::type value)
+    {
+        assert(index < sizeof...(Sizes));
+
+        m_data = field_table<bitter_type, BitNumbering, Sizes...>::set(
+                     m_data, index, value);
+    }
+
     /// @return The value create by the writer containing the bit fields
     typename bitter_type::type data() const
     {
@@ -0,0 +1,44 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace bitter
+{
+/// @brief Maps a signed integer to an unsigned integer such that values
+///        with a small magnitude get small codes:
+///
+///     0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, 2 -> 4, ...
+///
+/// This is the mapping used before storing signed values with a variable
+/// length code (e.g. leb128 or rice).
+template<class SignedType>
+typename std::make_unsigned<SignedType>::type zigzag_encode(SignedType value)
+{
+    static_assert(std::is_signed<SignedType>::value,
+                  "zigzag_encode(...) takes a signed integer");
+
+    using unsigned_type = typename std::make_unsigned<SignedType>::type;
+    const uint32_t sign_shift = sizeof(SignedType) * 8 - 1;
+
+    // The arithmetic right shift smears the sign bit over the value
+    return (static_cast<unsigned_type>(value) << 1) ^
+           static_cast<unsigned_type>(value >> sign_shift);
+}
+
+/// @brief The inverse of zigzag_encode(...)
+template<class UnsignedType>
+typename std::make_signed<UnsignedType>::type zigzag_decode(UnsignedType value)
+{
+    static_assert(std::is_unsigned<UnsignedType>::value,
+                  "zigzag_decode(...) takes an unsigned integer");
+
+    using signed_type = typename std::make_signed<UnsignedType>::type;
+
+    return static_cast<signed_type>((value >> 1) ^ (~(value & 1) + 1));
+}
+}
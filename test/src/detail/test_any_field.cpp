@@ -0,0 +1,60 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/any_field.hpp>
+
+#include <cstdint>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+enum class color
+{
+    red, green, blue
+};
+
+struct two
+{
+    uint8_t a;
+    color b;
+};
+
+struct three
+{
+    uint8_t a;
+    uint8_t b;
+    uint8_t c;
+};
+}
+
+TEST(test_any_field, initialize)
+{
+    using bitter::detail::any_field;
+
+    two value = { any_field<uint32_t>{ 7 }, any_field<uint32_t>{ 2 } };
+    EXPECT_EQ(7U, value.a);
+    EXPECT_EQ(color::blue, value.b);
+
+    bool flag = any_field<uint64_t>{ 1 };
+    EXPECT_TRUE(flag);
+}
+
+TEST(test_any_field, is_initializable)
+{
+    using bitter::detail::is_initializable;
+
+    EXPECT_TRUE((is_initializable<two, std::make_index_sequence<2>>::value));
+    EXPECT_FALSE((is_initializable<two, std::make_index_sequence<3>>::value));
+
+    // Remaining members are value initialized
+    EXPECT_TRUE((is_initializable<three,
+                 std::make_index_sequence<2>>::value));
+    EXPECT_TRUE((is_initializable<three,
+                 std::make_index_sequence<3>>::value));
+    EXPECT_FALSE((is_initializable<three,
+                  std::make_index_sequence<4>>::value));
+}
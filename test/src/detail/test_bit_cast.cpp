@@ -0,0 +1,38 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/bit_cast.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct bytes
+{
+    uint8_t data[4];
+};
+}
+
+TEST(test_bit_cast, bit_cast)
+{
+    bytes value = {{ 0x01, 0x02, 0x03, 0x04 }};
+
+    uint32_t word = bitter::detail::bit_cast<uint32_t>(value);
+    bytes back = bitter::detail::bit_cast<bytes>(word);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(value.data[i], back.data[i]);
+    }
+
+    EXPECT_EQ(0x3F800000U, bitter::detail::bit_cast<uint32_t>(1.0f));
+
+#if defined(BITTER_HAS_CONSTEXPR_BIT_CAST)
+    static_assert(bitter::detail::bit_cast<uint32_t>(1.0f) == 0x3F800000U,
+                  "");
+#endif
+}
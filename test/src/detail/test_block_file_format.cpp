@@ -0,0 +1,35 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/block_file_format.hpp>
+#include <bitter/lsb0_layout.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_block_file_format, offsets)
+{
+    using format = bitter::detail::block_file_format<
+        bitter::lsb0_layout<uint32_t, 3, 13, 16>>;
+
+    EXPECT_EQ(5U, format::column_words(100, 0));
+    EXPECT_EQ(21U, format::column_words(100, 1));
+    EXPECT_EQ(25U, format::column_words(100, 2));
+
+    EXPECT_EQ(0U, format::column_offset(100, 0));
+    EXPECT_EQ(5U, format::column_offset(100, 1));
+    EXPECT_EQ(26U, format::column_offset(100, 2));
+    EXPECT_EQ(51U, format::block_words(100));
+
+    EXPECT_EQ(0U, format::zone_offset(0, 0));
+    EXPECT_EQ(4U, format::zone_offset(0, 2));
+    EXPECT_EQ(8U, format::zone_offset(1, 1));
+    EXPECT_EQ(8U, format::block_offset(100, 0));
+    EXPECT_EQ(8U + 2 * 51, format::block_offset(100, 2));
+    EXPECT_EQ(8U + 10 * 51, format::zones_offset(100, 10));
+    EXPECT_EQ(8U + 10 * 51 + 3 * 2 * 10 + 3, format::file_words(100, 10));
+    EXPECT_EQ(8U + 3, format::file_words(100, 0));
+}
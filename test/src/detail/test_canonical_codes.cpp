@@ -0,0 +1,42 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/canonical_codes.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_canonical_codes, canonical_codes)
+{
+    // The example from RFC 1951 section 3.2.2
+    std::vector<uint8_t> lengths = { 3, 3, 3, 3, 3, 2, 4, 4 };
+
+    auto codes = bitter::canonical_codes(lengths.data(), lengths.size(), 15);
+
+    EXPECT_EQ((std::vector<uint32_t>{
+        0b010, 0b011, 0b100, 0b101, 0b110, 0b00, 0b1110, 0b1111 }), codes);
+}
+
+TEST(test_canonical_codes, unused_symbols)
+{
+    std::vector<uint8_t> lengths = { 0, 1, 0, 2, 2 };
+
+    auto codes = bitter::canonical_codes(lengths.data(), lengths.size(), 15);
+
+    EXPECT_EQ((std::vector<uint32_t>{ 0, 0b0, 0, 0b10, 0b11 }), codes);
+}
+
+TEST(test_canonical_codes, invalid_lengths)
+{
+    std::vector<uint8_t> over_subscribed = { 1, 1, 1 };
+    std::vector<uint8_t> too_long = { 1, 16 };
+
+    EXPECT_TRUE(bitter::canonical_codes(
+        over_subscribed.data(), over_subscribed.size(), 15).empty());
+    EXPECT_TRUE(bitter::canonical_codes(
+        too_long.data(), too_long.size(), 15).empty());
+}
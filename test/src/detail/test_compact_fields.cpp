@@ -0,0 +1,75 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/compact_fields.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+TEST(test_compact_fields, lsb0)
+{
+    using record = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+    using key = bitter::detail::compact_fields<record, 2, 0>;
+
+    static_assert(key::bits() == 20, "");
+
+    uint32_t value = record::set<0>(0, 0xA);
+    value = record::set<1>(value, 0xFFF);
+    value = record::set<2>(value, 0x1234);
+
+    EXPECT_EQ(0x1234AU, key::get(value));
+    EXPECT_EQ(0xA1234U, (bitter::detail::compact_fields<record, 0, 2>::get(value)));
+}
+
+TEST(test_compact_fields, msb0)
+{
+    using record = bitter::msb0_layout<uint64_t, 64>;
+    using key = bitter::detail::compact_fields<record, 0>;
+
+    static_assert(key::bits() == 64, "");
+    EXPECT_EQ(0x0123456789ABCDEFU, key::get(0x0123456789ABCDEFU));
+}
+
+TEST(test_compact_fields, mask)
+{
+    using record = bitter::msb0_layout<uint32_t, 4, 12, 16>;
+
+    static_assert(bitter::detail::compact_fields<record, 0, 2>::mask() ==
+                  0xF000FFFFU, "");
+    static_assert(bitter::detail::compact_fields<record, 0, 2>::is_descending(), "");
+    static_assert(!bitter::detail::compact_fields<record, 2, 0>::is_descending(), "");
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_compact_fields, wide)
+{
+    using record = bitter::lsb0_layout<bitter::u128, 64, 16, 48>;
+    using key = bitter::detail::compact_fields<record, 0, 2>;
+    using narrow = bitter::detail::compact_fields<record, 1, 2>;
+
+    static_assert(key::bits() == 112, "");
+    static_assert(std::is_same<key::packed_type, bitter::uint128_t>::value,
+                  "");
+    static_assert(std::is_same<narrow::packed_type, uint64_t>::value, "");
+
+    bitter::uint128_t value = record::set<0>(0, 0x0123456789ABCDEFU);
+    value = record::set<1>(value, 0xFFFF);
+    value = record::set<2>(value, 0xBA9876543210U);
+
+    bitter::uint128_t expected =
+        (bitter::uint128_t(0x0123456789ABCDEFU) << 48) | 0xBA9876543210U;
+
+    EXPECT_TRUE(expected == key::get(value));
+    EXPECT_EQ(0xFFFFBA9876543210U, narrow::get(value));
+
+    using single = bitter::detail::compact_fields<
+        bitter::msb0_layout<bitter::u128, 128>, 0>;
+    EXPECT_TRUE(value == single::get(value));
+}
+#endif
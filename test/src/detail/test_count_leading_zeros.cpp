@@ -0,0 +1,22 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/count_leading_zeros.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_count_leading_zeros, count_leading_zeros)
+{
+    EXPECT_EQ(63U, bitter::count_leading_zeros(1U));
+    EXPECT_EQ(0U, bitter::count_leading_zeros(0x8000000000000000U));
+    EXPECT_EQ(32U, bitter::count_leading_zeros(0xFFFFFFFFU));
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(63U - i, bitter::count_leading_zeros(uint64_t{1} << i));
+    }
+}
@@ -0,0 +1,22 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/count_trailing_zeros.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_count_trailing_zeros, count_trailing_zeros)
+{
+    EXPECT_EQ(0U, bitter::count_trailing_zeros(1U));
+    EXPECT_EQ(63U, bitter::count_trailing_zeros(0x8000000000000000U));
+    EXPECT_EQ(32U, bitter::count_trailing_zeros(0xFFFFFFFF00000000U));
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(i, bitter::count_trailing_zeros(uint64_t{1} << i));
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/deposit_bits.hpp>
+#include <bitter/detail/extract_bits.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_deposit_bits, deposit)
+{
+    EXPECT_EQ(0U, bitter::deposit_bits(0xFFFFFFFFFFFFFFFFU, 0));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFU,
+              bitter::deposit_bits(0xFFFFFFFFFFFFFFFFU, 0xFFFFFFFFFFFFFFFFU));
+    EXPECT_EQ(0x8000000000000001U, bitter::deposit_bits(0x5U,
+                                                        0x8000000000000003U));
+    EXPECT_EQ(0x0A0BU, bitter::deposit_bits(0xAB, 0x0F0F));
+    EXPECT_EQ(0x80U, bitter::deposit_bits(0x2, 0x81));
+}
+
+TEST(test_deposit_bits, inverse_of_extract_bits)
+{
+    uint64_t mask = 0x00FF00F0F0F0000FU;
+    uint64_t value = 0x123456789ABCDEF0U;
+
+    EXPECT_EQ(value & mask, bitter::deposit_bits(
+                  bitter::extract_bits(value, mask), mask));
+}
@@ -0,0 +1,21 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/extract_bits.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_extract_bits, extract)
+{
+    EXPECT_EQ(0U, bitter::extract_bits(0xFFFFFFFFFFFFFFFFU, 0));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFU,
+              bitter::extract_bits(0xFFFFFFFFFFFFFFFFU, 0xFFFFFFFFFFFFFFFFU));
+    EXPECT_EQ(0x5U, bitter::extract_bits(0x8000000000000001U,
+                                         0x8000000000000003U));
+    EXPECT_EQ(0xABU, bitter::extract_bits(0x0A0B, 0x0F0F));
+    EXPECT_EQ(0x2U, bitter::extract_bits(0x80, 0x81));
+}
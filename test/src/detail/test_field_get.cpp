@@ -62,3 +62,28 @@ TEST(test_field_get, field_u24)
         EXPECT_EQ(f1, 0xF0000U);
     }
 }
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_field_get, field_u128)
+{
+    bitter::uint128_t value =
+        (bitter::uint128_t(0x0123456789ABCDEFU) << 64) | 0xFEDCBA9876543210U;
+
+    // A field in each half and one straddling the halves
+    auto low = bitter::field_get<
+               bitter::u128, bitter::lsb0, 0, 16, 96, 16>(value);
+    auto middle = bitter::field_get<
+                  bitter::u128, bitter::lsb0, 1, 16, 96, 16>(value);
+    auto high = bitter::field_get<
+                bitter::u128, bitter::lsb0, 2, 16, 96, 16>(value);
+
+    EXPECT_TRUE(low == 0x3210U);
+    EXPECT_TRUE(middle == ((bitter::uint128_t(0x456789ABCDEFU) << 48) |
+                           0xFEDCBA987654U));
+    EXPECT_TRUE(high == 0x0123U);
+
+    auto first = bitter::field_get<
+                 bitter::u128, bitter::msb0, 0, 16, 96, 16>(value);
+    EXPECT_TRUE(first == 0x0123U);
+}
+#endif
@@ -36,3 +36,15 @@ TEST(test_field_mask, field_mask3)
 {
     EXPECT_EQ(0xFFFFFFU, (bitter::field_mask<bitter::u24, 0, 24>()));
 }
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_field_mask, field_mask_u128)
+{
+    bitter::uint128_t all = ~bitter::uint128_t{0};
+
+    EXPECT_TRUE(all == (bitter::field_mask<bitter::u128, 0, 128>()));
+    EXPECT_TRUE((all >> 28) == (bitter::field_mask<bitter::u128, 1, 28, 100>()));
+    EXPECT_TRUE(0xFFFFFFFFFFFFFFFFU == (bitter::field_mask<bitter::u72, 1, 8, 64>()));
+    EXPECT_TRUE(0xFFU == (bitter::field_mask<bitter::u72, 0, 8, 64>()));
+}
+#endif
@@ -64,3 +64,17 @@ TEST(test_field_set, field_set_24)
         EXPECT_EQ(0x1ABCD0U, temp);
     }
 }
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_field_set, field_set_128)
+{
+    bitter::uint128_t temp = 0U;
+
+    temp = bitter::field_set<
+           bitter::u96, bitter::msb0, 1, 40, 48, 8>(temp, 0xABCDEF012345U);
+    temp = bitter::field_set<
+           bitter::u96, bitter::msb0, 2, 40, 48, 8>(temp, 0x67U);
+
+    EXPECT_TRUE(temp == 0xABCDEF01234567U);
+}
+#endif
@@ -0,0 +1,75 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/field_table.hpp>
+
+#include <bitter/lsb0.hpp>
+#include <bitter/msb0.hpp>
+#include <bitter/types.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_field_table, non_uniform)
+{
+    using lsb0_table = bitter::field_table<bitter::u16, bitter::lsb0, 1, 4, 6, 5>;
+
+    EXPECT_FALSE(lsb0_table::is_uniform());
+    EXPECT_EQ(6U, lsb0_table::max_size());
+    EXPECT_EQ(0U, lsb0_table::offset(0));
+    EXPECT_EQ(1U, lsb0_table::offset(1));
+    EXPECT_EQ(5U, lsb0_table::offset(2));
+    EXPECT_EQ(11U, lsb0_table::offset(3));
+    EXPECT_EQ(0x1FU, lsb0_table::mask(3));
+
+    using msb0_table = bitter::field_table<bitter::u16, bitter::msb0, 1, 4, 6, 5>;
+
+    EXPECT_FALSE(msb0_table::is_uniform());
+    EXPECT_EQ(15U, msb0_table::offset(0));
+    EXPECT_EQ(11U, msb0_table::offset(1));
+    EXPECT_EQ(5U, msb0_table::offset(2));
+    EXPECT_EQ(0U, msb0_table::offset(3));
+    EXPECT_EQ(0x3FU, msb0_table::mask(2));
+}
+
+TEST(test_field_table, uniform)
+{
+    using lsb0_table = bitter::field_table<bitter::u32, bitter::lsb0,
+                       4, 4, 4, 4, 4, 4, 4, 4>;
+
+    EXPECT_TRUE(lsb0_table::is_uniform());
+
+    using msb0_table = bitter::field_table<bitter::u32, bitter::msb0,
+                       4, 4, 4, 4, 4, 4, 4, 4>;
+
+    EXPECT_TRUE(msb0_table::is_uniform());
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(i * 4, lsb0_table::offset(i));
+        EXPECT_EQ(28 - (i * 4), msb0_table::offset(i));
+        EXPECT_EQ(0xFU, lsb0_table::mask(i));
+        EXPECT_EQ(0xFU, msb0_table::mask(i));
+    }
+
+    using single_table = bitter::field_table<bitter::u8, bitter::msb0, 8>;
+    EXPECT_TRUE(single_table::is_uniform());
+    EXPECT_EQ(0U, single_table::offset(0));
+    EXPECT_EQ(0xFFU, single_table::mask(0));
+}
+
+TEST(test_field_table, get_set)
+{
+    using table = bitter::field_table<bitter::u32, bitter::lsb0, 4, 12, 16>;
+
+    uint32_t value = 0x12345678U;
+    EXPECT_EQ(0x8U, table::get(value, 0));
+    EXPECT_EQ(0x567U, table::get(value, 1));
+    EXPECT_EQ(0x1234U, table::get(value, 2));
+
+    value = table::set(value, 1, 0xABCU);
+    EXPECT_EQ(0x1234ABC8U, value);
+}
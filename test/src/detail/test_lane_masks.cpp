@@ -0,0 +1,38 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/lane_masks.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_lane_masks, lsb0)
+{
+    using masks = bitter::detail::lane_masks<
+                  bitter::lsb0_layout<uint32_t, 1, 7, 8, 16>>;
+
+    static_assert(masks::all() == 0xFFFFFFFFU, "");
+    static_assert(masks::top() == 0x80008081U, "");
+    static_assert(masks::bottom() == 0x00010103U, "");
+    static_assert(masks::low() == 0x7FFF7F7EU, "");
+    static_assert(masks::sizes() == 4, "");
+}
+
+TEST(test_lane_masks, sizes)
+{
+    using masks = bitter::detail::lane_masks<
+                  bitter::msb0_layout<bitter::u24, 4, 8, 4, 8>>;
+
+    static_assert(masks::all() == 0xFFFFFFU, "");
+    static_assert(masks::top() == 0x880880U, "");
+    static_assert(masks::sizes() == 2, "");
+    static_assert(masks::size(0) == 4, "");
+    static_assert(masks::size(1) == 8, "");
+    static_assert(masks::size_top(0) == 0x800800U, "");
+    static_assert(masks::size_top(1) == 0x080080U, "");
+}
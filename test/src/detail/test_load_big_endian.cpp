@@ -0,0 +1,24 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/load_big_endian.hpp>
+
+#include <bitter/types.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_load_big_endian, load_big_endian)
+{
+    const uint8_t data[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+    EXPECT_EQ(0x01U, bitter::load_big_endian<bitter::u8>(data));
+    EXPECT_EQ(0x0102U, bitter::load_big_endian<bitter::u16>(data));
+    EXPECT_EQ(0x010203U, bitter::load_big_endian<bitter::u24>(data));
+    EXPECT_EQ(0x01020304U, bitter::load_big_endian<bitter::u32>(data));
+    EXPECT_EQ(0x0102030405U, bitter::load_big_endian<bitter::u40>(data));
+    EXPECT_EQ(0x0102030405060708U, bitter::load_big_endian<bitter::u64>(data));
+}
@@ -0,0 +1,26 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/load_layout.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_load_layout, load)
+{
+    const uint8_t data[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+
+    EXPECT_EQ(0x01020304U,
+              (bitter::load_layout<bitter::msb0_layout<uint32_t, 32>>(data)));
+    EXPECT_EQ(0x04030201U,
+              (bitter::load_layout<bitter::lsb0_layout<uint32_t, 32>>(data)));
+    EXPECT_EQ(0x0102030405U,
+              (bitter::load_layout<bitter::msb0_layout<bitter::u40, 40>>(data)));
+    EXPECT_EQ(0x030201U,
+              (bitter::load_layout<bitter::lsb0_layout<bitter::u24, 24>>(data)));
+}
@@ -0,0 +1,25 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/max_sizes.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_max_sizes, max_sizes)
+{
+    EXPECT_EQ(1U, (bitter::max_sizes<1>()));
+}
+
+TEST(test_max_sizes, max_sizes1)
+{
+    EXPECT_EQ(4U, (bitter::max_sizes<1, 3, 4>()));
+}
+
+TEST(test_max_sizes, max_sizes2)
+{
+    EXPECT_EQ(16U, (bitter::max_sizes<1, 16, 4, 8, 3>()));
+}
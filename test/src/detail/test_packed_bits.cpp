@@ -0,0 +1,31 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/packed_bits.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_packed_bits, read_write)
+{
+    std::vector<uint64_t> words(3, 0);
+
+    bitter::write_bits(words.data(), 0, 4, 0xA);
+    bitter::write_bits(words.data(), 60, 8, 0xBC);
+    bitter::write_bits(words.data(), 68, 64, 0x0123456789ABCDEFU);
+
+    EXPECT_EQ(0xC00000000000000AU, words[0]);
+    EXPECT_EQ(0xA, bitter::read_bits(words.data(), 0, 4));
+    EXPECT_EQ(0xBC, bitter::read_bits(words.data(), 60, 8));
+    EXPECT_EQ(0x0123456789ABCDEFU, bitter::read_bits(words.data(), 68, 64));
+    EXPECT_EQ(0U, bitter::read_bits(words.data(), 5, 0));
+
+    // Overwrite in place
+    bitter::write_bits(words.data(), 62, 4, 0x5);
+    EXPECT_EQ(0x5, bitter::read_bits(words.data(), 62, 4));
+    EXPECT_EQ(0x94, bitter::read_bits(words.data(), 60, 8));
+}
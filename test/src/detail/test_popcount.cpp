@@ -0,0 +1,18 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/popcount.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_popcount, popcount)
+{
+    EXPECT_EQ(0U, bitter::popcount(0U));
+    EXPECT_EQ(1U, bitter::popcount(0x8000000000000000U));
+    EXPECT_EQ(64U, bitter::popcount(~uint64_t{0}));
+    EXPECT_EQ(8U, bitter::popcount(0x0101010101010101U));
+}
@@ -0,0 +1,24 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/read_msb0_bits.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_read_msb0_bits, read)
+{
+    uint8_t data[] = { 0x12, 0x34, 0x56, 0x78, 0x9A };
+
+    EXPECT_EQ(0x0U, bitter::read_msb0_bits(data, 0, 3));
+    EXPECT_EQ(0x1U, bitter::read_msb0_bits(data, 0, 4));
+    EXPECT_EQ(0x123456U, bitter::read_msb0_bits(data, 0, 24));
+    EXPECT_EQ(0x23456U, bitter::read_msb0_bits(data, 4, 20));
+    EXPECT_EQ(0x3456789AU, bitter::read_msb0_bits(data, 8, 32));
+    EXPECT_EQ(0x91A2B3C4U, bitter::read_msb0_bits(data, 3, 32));
+    EXPECT_EQ(0x0U, bitter::read_msb0_bits(data, 39, 1));
+    EXPECT_EQ(0x1U, bitter::read_msb0_bits(data, 35, 1));
+}
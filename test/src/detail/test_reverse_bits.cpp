@@ -0,0 +1,25 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/reverse_bits.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_reverse_bits, reverse_bits)
+{
+    EXPECT_EQ(0x8000000000000000U, bitter::reverse_bits(1U));
+    EXPECT_EQ(0x0F00000000000000U, bitter::reverse_bits(0xF0U));
+    EXPECT_EQ(0x1E6A2C48F7B3D591U, bitter::reverse_bits(0x89ABCDEF12345678U));
+}
+
+TEST(test_reverse_bits, reverse_bits_width)
+{
+    EXPECT_EQ(0b1U, bitter::reverse_bits(0b1U, 1));
+    EXPECT_EQ(0b011U, bitter::reverse_bits(0b110U, 3));
+    EXPECT_EQ(0b1101U, bitter::reverse_bits(0b1011U, 4));
+    EXPECT_EQ(0x8000000000000000U, bitter::reverse_bits(1U, 64));
+}
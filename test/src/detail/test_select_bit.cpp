@@ -0,0 +1,43 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/select_bit.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+TEST(test_select_bit, select_bit)
+{
+    EXPECT_EQ(0U, bitter::select_bit(1U, 0));
+    EXPECT_EQ(63U, bitter::select_bit(0x8000000000000001U, 1));
+    EXPECT_EQ(12U, bitter::select_bit(0xF0F0U, 4));
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(i, bitter::select_bit(~uint64_t{0}, i));
+    }
+}
+
+TEST(test_select_bit, random)
+{
+    for (uint32_t n = 0; n < 1000; ++n)
+    {
+        uint64_t value = (uint64_t(rand()) << 42) ^ (uint64_t(rand()) << 21) ^
+                         uint64_t(rand());
+
+        uint32_t rank = 0;
+
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            if ((value >> i) & 1U)
+            {
+                EXPECT_EQ(i, bitter::select_bit(value, rank));
+                ++rank;
+            }
+        }
+    }
+}
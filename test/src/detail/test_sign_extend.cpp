@@ -0,0 +1,20 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/sign_extend.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_sign_extend, sign_extend)
+{
+    EXPECT_EQ(-1, bitter::detail::sign_extend(0xF, 4));
+    EXPECT_EQ(7, bitter::detail::sign_extend(0x7, 4));
+    EXPECT_EQ(-8, bitter::detail::sign_extend(0x8, 4));
+    EXPECT_EQ(0, bitter::detail::sign_extend(0x10, 4));
+    EXPECT_EQ(-1, bitter::detail::sign_extend(~uint64_t{0}, 64));
+    EXPECT_EQ(1, bitter::detail::sign_extend(1, 64));
+}
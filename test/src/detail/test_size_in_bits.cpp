@@ -70,3 +70,25 @@ TEST(test_size_in_bits, uint64)
 {
     EXPECT_EQ(64U, (bitter::size_in_bits<uint64_t>()));
 }
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_size_in_bits, u72)
+{
+    EXPECT_EQ(72U, (bitter::size_in_bits<bitter::u72>()));
+}
+
+TEST(test_size_in_bits, u96)
+{
+    EXPECT_EQ(96U, (bitter::size_in_bits<bitter::u96>()));
+}
+
+TEST(test_size_in_bits, u128)
+{
+    EXPECT_EQ(128U, (bitter::size_in_bits<bitter::u128>()));
+}
+
+TEST(test_size_in_bits, uint128)
+{
+    EXPECT_EQ(128U, (bitter::size_in_bits<bitter::uint128_t>()));
+}
+#endif
@@ -0,0 +1,24 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/store_little_endian.hpp>
+
+#include <bitter/types.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_store_little_endian, store_little_endian)
+{
+    std::vector<uint8_t> data(8, 0);
+
+    bitter::store_little_endian<bitter::u24>(0x010203U, data.data());
+    EXPECT_EQ((std::vector<uint8_t>{ 3, 2, 1, 0, 0, 0, 0, 0 }), data);
+
+    bitter::store_little_endian<bitter::u64>(0x0102030405060708U, data.data());
+    EXPECT_EQ((std::vector<uint8_t>{ 8, 7, 6, 5, 4, 3, 2, 1 }), data);
+}
@@ -0,0 +1,22 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/swap_bytes.hpp>
+#include <bitter/types.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_swap_bytes, swap)
+{
+    EXPECT_EQ(0xABU, bitter::swap_bytes<bitter::u8>(0xAB));
+    EXPECT_EQ(0xCDABU, bitter::swap_bytes<bitter::u16>(0xABCD));
+    EXPECT_EQ(0x563412U, bitter::swap_bytes<bitter::u24>(0x123456));
+    EXPECT_EQ(0x78563412U, bitter::swap_bytes<bitter::u32>(0x12345678));
+    EXPECT_EQ(0xAB89674523U, bitter::swap_bytes<bitter::u40>(0x23456789AB));
+    EXPECT_EQ(0xEFCDAB8967452301U,
+              bitter::swap_bytes<bitter::u64>(0x0123456789ABCDEFU));
+}
@@ -29,3 +29,13 @@ TEST(test_to_type, to_type)
     EXPECT_TRUE((same<bitter::u56, bitter::u56>::value));
     EXPECT_TRUE((same<bitter::u64, bitter::u64>::value));
 }
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_to_type, to_type_128)
+{
+    EXPECT_TRUE((same<bitter::uint128_t, bitter::u128>::value));
+    EXPECT_TRUE((same<bitter::u72, bitter::u72>::value));
+    EXPECT_TRUE((same<bitter::u96, bitter::u96>::value));
+    EXPECT_TRUE((same<bitter::u128, bitter::u128>::value));
+}
+#endif
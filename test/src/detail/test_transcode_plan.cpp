@@ -0,0 +1,52 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/transcode_plan.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_transcode_plan, same_order)
+{
+    // Same sizes and order, lsb0 to msb0 with all fields reversed
+    using from = bitter::lsb0_layout<uint32_t, 8, 8, 16>;
+    using to = bitter::msb0_layout<uint32_t, 16, 8, 8>;
+    using plan = bitter::detail::transcode_plan<from, to, 2, 1, 0>;
+
+    static_assert(plan::groups() == 1, "");
+    static_assert(plan::group_distance(0) == 0, "");
+    static_assert(plan::group_mask(0) == 0xFFFFFFFFU, "");
+}
+
+TEST(test_transcode_plan, groups)
+{
+    using from = bitter::lsb0_layout<uint32_t, 4, 4, 8, 16>;
+    using to = bitter::lsb0_layout<uint32_t, 4, 4, 16, 8>;
+    using plan = bitter::detail::transcode_plan<from, to, 1, 0, 3, 2>;
+
+    // Fields 0 and 1 swap, field 3 moves down 8 and field 2 up 16
+    static_assert(plan::groups() == 4, "");
+    static_assert(plan::group_distance(0) == -4, "");
+    static_assert(plan::group_mask(0) == 0xF0, "");
+    static_assert(plan::group_distance(1) == 4, "");
+    static_assert(plan::group_distance(2) == -8, "");
+    static_assert(plan::group_mask(2) == 0xFFFF0000U, "");
+    static_assert(plan::group_distance(3) == 16, "");
+    static_assert(plan::group_mask(3) == 0xFF00, "");
+}
+
+TEST(test_transcode_plan, no_field)
+{
+    using from = bitter::lsb0_layout<uint16_t, 8, 8>;
+    using to = bitter::lsb0_layout<uint32_t, 8, 8, 16>;
+    using plan = bitter::detail::transcode_plan<from, to, 0, 1, bitter::no_field>;
+
+    static_assert(plan::groups() == 1, "");
+    static_assert(!plan::is_mapped(2), "");
+    static_assert(plan::group_mask(0) == 0xFFFF, "");
+}
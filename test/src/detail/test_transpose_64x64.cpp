@@ -0,0 +1,58 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/detail/transpose_64x64.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+TEST(test_transpose_64x64, transpose)
+{
+    uint64_t rows[64];
+    uint64_t original[64];
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        rows[i] = (uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^ rand();
+        original[i] = rows[i];
+    }
+
+    bitter::transpose_64x64(rows);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        for (uint32_t j = 0; j < 64; ++j)
+        {
+            ASSERT_EQ((original[i] >> j) & 1U, (rows[j] >> i) & 1U);
+        }
+    }
+
+    // Transposing twice gives the original matrix
+    bitter::transpose_64x64(rows);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(original[i], rows[i]);
+    }
+}
+
+TEST(test_transpose_64x64, identity)
+{
+    uint64_t rows[64];
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        rows[i] = uint64_t{1} << i;
+    }
+
+    bitter::transpose_64x64(rows);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(uint64_t{1} << i, rows[i]);
+    }
+}
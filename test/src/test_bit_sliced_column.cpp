@@ -0,0 +1,145 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/bit_sliced_column.hpp>
+#include <bitter/lsb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+template<uint32_t Bits, class Predicate>
+void check(const bitter::bit_sliced_column<Bits>& column,
+           const std::vector<uint64_t>& result, Predicate predicate)
+{
+    ASSERT_EQ((column.size() + 63) / 64, result.size());
+
+    for (uint64_t i = 0; i < result.size() * 64; ++i)
+    {
+        bool expected = i < column.size() && predicate(column.at(i));
+        ASSERT_EQ(expected, bool((result[i / 64] >> (i % 64)) & 1U)) << i;
+    }
+}
+
+template<uint32_t Bits>
+void check_column(uint64_t count)
+{
+    uint64_t max = ~uint64_t{0} >> (64 - Bits);
+    std::vector<uint64_t> values(count);
+
+    for (auto& value : values)
+    {
+        value = ((uint64_t(rand()) << 32) ^ rand()) & max;
+    }
+
+    bitter::bit_sliced_column<Bits> column(values.data(), count);
+    ASSERT_EQ(count, column.size());
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(values[i], column.at(i));
+    }
+
+    std::vector<uint64_t> result(column.result_words());
+
+    uint64_t constants[] = { 0, 1, max / 2, max - 1, max,
+                             count == 0 ? 0 : values[count / 2]
+                           };
+
+    for (uint64_t c : constants)
+    {
+        SCOPED_TRACE(c);
+
+        column.equal(c, result.data());
+        check(column, result, [c](uint64_t v) { return v == c; });
+
+        column.not_equal(c, result.data());
+        check(column, result, [c](uint64_t v) { return v != c; });
+
+        column.less(c, result.data());
+        check(column, result, [c](uint64_t v) { return v < c; });
+
+        column.less_equal(c, result.data());
+        check(column, result, [c](uint64_t v) { return v <= c; });
+
+        column.greater(c, result.data());
+        check(column, result, [c](uint64_t v) { return v > c; });
+
+        column.greater_equal(c, result.data());
+        check(column, result, [c](uint64_t v) { return v >= c; });
+
+        column.between(c / 2, c, result.data());
+        check(column, result, [c](uint64_t v) { return v >= c / 2 && v <= c; });
+    }
+}
+}
+
+TEST(test_bit_sliced_column, predicates)
+{
+    check_column<1>(100);
+    check_column<5>(1000);
+    check_column<9>(64);
+    check_column<9>(1);
+    check_column<32>(200);
+    check_column<64>(130);
+}
+
+TEST(test_bit_sliced_column, out_of_range_constant)
+{
+    std::vector<uint8_t> values = { 0, 7, 31, 12 };
+    bitter::bit_sliced_column<5> column(values.data(), values.size());
+
+    std::vector<uint64_t> result(column.result_words());
+
+    column.less(32, result.data());
+    EXPECT_EQ(0xFU, result[0]);
+
+    column.equal(32, result.data());
+    EXPECT_EQ(0U, result[0]);
+
+    column.greater(31, result.data());
+    EXPECT_EQ(0U, result[0]);
+
+    column.greater_equal(7, result.data());
+    EXPECT_EQ(0xEU, result[0]);
+}
+
+TEST(test_bit_sliced_column, slice_field)
+{
+    using record = bitter::lsb0_layout<uint32_t, 9, 5, 18>;
+
+    std::vector<uint32_t> records(300);
+
+    for (uint32_t i = 0; i < records.size(); ++i)
+    {
+        uint32_t value = record::set<0>(0, i % 512);
+        records[i] = record::set<1>(value, i % 20);
+    }
+
+    auto column = bitter::slice_field<record, 1>(records.data(), records.size());
+    EXPECT_EQ(300U, column.size());
+    EXPECT_EQ(13U, column.at(33));
+
+    std::vector<uint64_t> result(column.result_words());
+    column.equal(19, result.data());
+
+    for (uint32_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(i % 20 == 19, bool((result[i / 64] >> (i % 64)) & 1U));
+    }
+}
+
+TEST(test_bit_sliced_column, empty)
+{
+    bitter::bit_sliced_column<9> column(static_cast<const uint16_t*>(nullptr), 0);
+
+    EXPECT_EQ(0U, column.size());
+    EXPECT_EQ(0U, column.result_words());
+    column.equal(1, nullptr);
+}
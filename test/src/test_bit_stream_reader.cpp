@@ -0,0 +1,124 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/bit_stream_reader.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_bit_stream_reader, read_msb0)
+{
+    std::vector<uint8_t> data = { 0xA5, 0x0F, 0x12, 0x34 };
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+
+    EXPECT_EQ(32U, reader.bits_left());
+    EXPECT_EQ(0x1U, reader.read(1));
+    EXPECT_EQ(0x0U, reader.read(1));
+    EXPECT_EQ(0x25U, reader.read(6));
+    EXPECT_EQ(0x0U, reader.read(4));
+    EXPECT_EQ(0xF12U, reader.read(12));
+    EXPECT_EQ(8U, reader.bits_left());
+    EXPECT_EQ(0x34U, reader.read(8));
+    EXPECT_EQ(0U, reader.bits_left());
+}
+
+TEST(test_bit_stream_reader, read_lsb0)
+{
+    std::vector<uint8_t> data = { 0xA5, 0x0F, 0x12, 0x34 };
+    bitter::bit_stream_reader<bitter::lsb0> reader(data.data(), data.size());
+
+    EXPECT_EQ(0x1U, reader.read(1));
+    EXPECT_EQ(0x0U, reader.read(1));
+    EXPECT_EQ(0x29U, reader.read(6));
+    EXPECT_EQ(0xFU, reader.read(4));
+    EXPECT_EQ(0x120U, reader.read(12));
+    EXPECT_EQ(0x34U, reader.read(8));
+    EXPECT_EQ(0U, reader.bits_left());
+}
+
+TEST(test_bit_stream_reader, read_wide)
+{
+    std::vector<uint8_t> data(24);
+    for (uint32_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    {
+        bitter::bit_stream_reader<bitter::msb0> reader(
+            data.data(), data.size());
+
+        EXPECT_EQ(0x0U, reader.read(4));
+        EXPECT_EQ(0x1020304050607080U, reader.read(64));
+        EXPECT_EQ(0x9U, reader.read(4));
+        EXPECT_EQ(0x0A0B0C0D0E0F10U, reader.read(56));
+        EXPECT_EQ(0x1112131415161718U, reader.read(64));
+    }
+    {
+        bitter::bit_stream_reader<bitter::lsb0> reader(
+            data.data(), data.size());
+
+        EXPECT_EQ(0x1U, reader.read(4));
+        EXPECT_EQ(0x9080706050403020U, reader.read(64));
+        EXPECT_EQ(0x0U, reader.read(4));
+        EXPECT_EQ(0x100F0E0D0C0B0AU, reader.read(56));
+        EXPECT_EQ(0x1817161514131211U, reader.read(64));
+    }
+}
+
+TEST(test_bit_stream_reader, peek_consume)
+{
+    std::vector<uint8_t> data = { 0x00, 0x10, 0xFF };
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+    reader.refill();
+
+    EXPECT_EQ(24U, reader.buffered_bits());
+    EXPECT_EQ(11U, reader.count_zeros());
+    EXPECT_EQ(0x001U, reader.peek(12));
+    reader.consume(12);
+    EXPECT_EQ(4U, reader.count_zeros());
+
+    // Peeking past the end reads zeros
+    EXPECT_EQ(0x0FF0U, reader.peek(16));
+
+    reader.skip(12);
+    EXPECT_EQ(0U, reader.bits_left());
+    EXPECT_EQ(0U, reader.count_zeros());
+}
+
+TEST(test_bit_stream_reader, skip)
+{
+    std::vector<uint8_t> data(100, 0);
+    data[99] = 0x80;
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+
+    reader.skip(99 * 8);
+    EXPECT_EQ(8U, reader.bits_left());
+    EXPECT_EQ(1U, reader.read(1));
+}
+
+TEST(test_bit_stream_reader, past_the_end)
+{
+    std::vector<uint8_t> data = { 0xAB, 0xCD };
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+    EXPECT_EQ(0xABCU, reader.read(12));
+    EXPECT_TRUE(reader.is_valid());
+
+    // Reading past the end drops the rest and reads zero from then on
+    EXPECT_EQ(0U, reader.read(8));
+    EXPECT_FALSE(reader.is_valid());
+    EXPECT_EQ(0U, reader.bits_left());
+    EXPECT_EQ(0U, reader.read(1));
+
+    bitter::bit_stream_reader<bitter::lsb0> skipper(data.data(), data.size());
+    skipper.skip(17);
+    EXPECT_FALSE(skipper.is_valid());
+    EXPECT_EQ(0U, skipper.bits_left());
+}
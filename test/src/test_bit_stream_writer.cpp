@@ -0,0 +1,89 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/bit_stream_writer.hpp>
+#include <bitter/bit_stream_reader.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_bit_stream_writer, write_msb0)
+{
+    std::vector<uint8_t> data(4, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+
+    writer.write(0x1, 1);
+    writer.write(0x0, 1);
+    writer.write(0x25, 6);
+    writer.write(0x0, 4);
+    writer.write(0xF12, 12);
+    EXPECT_EQ(24U, writer.bits_written());
+    writer.write(0x3, 2);
+    EXPECT_EQ(4U, writer.size());
+    writer.flush();
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0xA5, 0x0F, 0x12, 0xC0 }), data);
+}
+
+TEST(test_bit_stream_writer, write_lsb0)
+{
+    std::vector<uint8_t> data(4, 0);
+    bitter::bit_stream_writer<bitter::lsb0> writer(data.data(), data.size());
+
+    writer.write(0x1, 1);
+    writer.write(0x0, 1);
+    writer.write(0x29, 6);
+    writer.write(0xF, 4);
+    writer.write(0x120, 12);
+    writer.write(0x3, 2);
+    writer.flush();
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0xA5, 0x0F, 0x12, 0x03 }), data);
+}
+
+template<class BitNumbering>
+void test_round_trip()
+{
+    const uint32_t count = 1000;
+
+    std::vector<uint64_t> values(count);
+    std::vector<uint32_t> bits(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        bits[i] = rand() % 65;
+        uint64_t value = (uint64_t(rand()) << 42) ^ (uint64_t(rand()) << 21) ^
+                         uint64_t(rand());
+        values[i] = bits[i] == 64 ? value :
+                    value & ((uint64_t{1} << bits[i]) - 1);
+    }
+
+    std::vector<uint8_t> data(count * 8);
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        writer.write(values[i], bits[i]);
+    }
+    writer.flush();
+
+    bitter::bit_stream_reader<BitNumbering> reader(data.data(), writer.size());
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(values[i], reader.read(bits[i]));
+    }
+
+    EXPECT_LT(reader.bits_left(), 8U);
+}
+
+TEST(test_bit_stream_writer, round_trip)
+{
+    test_round_trip<bitter::msb0>();
+    test_round_trip<bitter::lsb0>();
+}
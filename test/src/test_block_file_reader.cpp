@@ -0,0 +1,289 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/block_file_reader.hpp>
+#include <bitter/block_file_writer.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Timestamp, sensor id and reading
+using record = bitter::msb0_layout<uint64_t, 32, 10, 22>;
+
+std::vector<uint64_t> make_records(uint64_t count)
+{
+    std::vector<uint64_t> records;
+    uint64_t time = 1000;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        time += rand() % 10;
+
+        uint64_t value = record::set<0>(0, time);
+        value = record::set<1>(value, rand() % 1024);
+        value = record::set<2>(value, rand() % (1 << 22));
+        records.push_back(value);
+    }
+
+    return records;
+}
+
+template<uint32_t Field, class Reader>
+void check_scan(Reader& reader, const std::vector<uint64_t>& records,
+                uint64_t low, uint64_t high)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> expected;
+
+    for (uint64_t i = 0; i < records.size(); ++i)
+    {
+        uint64_t field = record::get<Field>(records[i]);
+
+        if (field >= low && field <= high)
+        {
+            expected.emplace_back(i, records[i]);
+        }
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> found;
+
+    uint64_t matches = reader.template scan<Field>(
+        low, high, [&found](uint64_t index, uint64_t value)
+    {
+        found.emplace_back(index, value);
+    });
+
+    EXPECT_EQ(expected.size(), matches);
+    EXPECT_EQ(expected, found);
+}
+}
+
+TEST(test_block_file_reader, scan)
+{
+    auto records = make_records(10000);
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 512);
+    writer.write(records.data(), records.size());
+    writer.finish();
+
+    bitter::block_file_reader<record> reader(
+        bitter::memory_source(file.data(), file.size()));
+
+    EXPECT_TRUE(reader.is_valid());
+    EXPECT_EQ(10000U, reader.records());
+    EXPECT_EQ(512U, reader.block_records());
+    EXPECT_EQ(20U, reader.blocks());
+
+    EXPECT_EQ(record::get<0>(records[0]), reader.zone_min(0, 0));
+    EXPECT_EQ(record::get<0>(records[511]), reader.zone_max(0, 0));
+
+    uint64_t first = record::get<0>(records.front());
+    uint64_t last = record::get<0>(records.back());
+
+    check_scan<0>(reader, records, first, last);
+    check_scan<0>(reader, records, first + 1000, first + 2000);
+    check_scan<0>(reader, records, last + 1, last + 100);
+    check_scan<1>(reader, records, 17, 17);
+    check_scan<2>(reader, records, 0, 1000);
+}
+
+TEST(test_block_file_reader, skipped_bytes)
+{
+    auto records = make_records(10000);
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 1000);
+    writer.write(records.data(), records.size());
+    writer.finish();
+
+    bitter::block_file_reader<record> reader(
+        bitter::memory_source(file.data(), file.size()));
+
+    // The header, zone maps and trailer
+    uint64_t metadata = (8 + 10 * 3 * 2 + 3) * 8;
+    EXPECT_EQ(metadata, reader.bytes_read());
+
+    // A narrow time range touches one or two of the 10 blocks
+    uint64_t time = record::get<0>(records[4500]);
+    check_scan<0>(reader, records, time, time);
+
+    uint64_t block_bytes = (500 + 157 + 344) * 8;
+    EXPECT_LE(reader.bytes_read(), metadata + 2 * block_bytes);
+    EXPECT_GE(reader.bytes_skipped(), 8 * block_bytes);
+    EXPECT_EQ(metadata + 10 * block_bytes,
+              reader.bytes_read() + reader.bytes_skipped());
+}
+
+TEST(test_block_file_reader, callback_source)
+{
+    auto records = make_records(3000);
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 256);
+    writer.write(records.data(), records.size());
+    writer.finish();
+
+    // Reads through a function as with pread(...)
+    uint64_t calls = 0;
+
+    auto source = bitter::make_callback_source(
+        [&file, &calls](uint64_t offset, uint64_t size, void* buffer)
+    {
+        EXPECT_EQ(0U, offset % 8);
+        EXPECT_LE(offset + size, file.size() * 8);
+
+        std::memcpy(buffer, reinterpret_cast<const uint8_t*>(file.data()) +
+                    offset, size);
+        ++calls;
+        return true;
+    }, file.size() * 8);
+
+    bitter::block_file_reader<record, decltype(source)> reader(source);
+    EXPECT_EQ(3000U, reader.records());
+    EXPECT_EQ(3U, calls);
+
+    uint64_t first = record::get<0>(records.front());
+    check_scan<0>(reader, records, first + 100, first + 3000);
+    check_scan<1>(reader, records, 1000, 1023);
+    EXPECT_GT(calls, 3U);
+    EXPECT_TRUE(reader.is_valid());
+}
+
+TEST(test_block_file_reader, failed_reads)
+{
+    auto records = make_records(3000);
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 256);
+    writer.write(records.data(), records.size());
+    writer.finish();
+
+    // Reads succeed until the limit of calls is reached
+    uint64_t limit = 0;
+
+    auto source = bitter::make_callback_source(
+        [&file, &limit](uint64_t offset, uint64_t size, void* buffer)
+    {
+        if (limit == 0)
+        {
+            return false;
+        }
+
+        --limit;
+        std::memcpy(buffer, reinterpret_cast<const uint8_t*>(file.data()) +
+                    offset, size);
+        return true;
+    }, file.size() * 8);
+
+    for (uint64_t reads = 0; reads < 3; ++reads)
+    {
+        limit = reads;
+        bitter::block_file_reader<record, decltype(source)> reader(source);
+        EXPECT_FALSE(reader.is_valid());
+        EXPECT_EQ(0U, reader.records());
+    }
+
+    limit = 3 + 5;
+    bitter::block_file_reader<record, decltype(source)> reader(source);
+    EXPECT_TRUE(reader.is_valid());
+
+    // The scan stops at the failed read
+    uint64_t calls = 0;
+    reader.scan<1>(0, 1023, [&calls](uint64_t index, uint64_t)
+    {
+        EXPECT_LT(index, 2 * 256U);
+        ++calls;
+    });
+
+    EXPECT_FALSE(reader.is_valid());
+    EXPECT_LE(calls, 2 * 256U);
+
+    // A memory source fails reads outside the file
+    bitter::memory_source memory(file.data(), file.size());
+    std::vector<uint64_t> buffer;
+
+    EXPECT_NE(nullptr, memory.read(0, file.size(), buffer));
+    EXPECT_EQ(nullptr, memory.read(1, file.size(), buffer));
+    EXPECT_EQ(nullptr, memory.read(file.size() + 1, 0, buffer));
+}
+
+TEST(test_block_file_reader, invalid)
+{
+    auto records = make_records(1000);
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 100);
+    writer.write(records.data(), records.size());
+    writer.finish();
+
+    auto is_valid = [](const std::vector<uint64_t>& words)
+    {
+        bitter::block_file_reader<record> reader(
+            bitter::memory_source(words.data(), words.size()));
+
+        if (!reader.is_valid())
+        {
+            // An invalid file reads as an empty one
+            EXPECT_EQ(0U, reader.records());
+            EXPECT_EQ(0U, reader.blocks());
+            EXPECT_EQ(0U, reader.template scan<0>(0, ~uint64_t{0},
+                [](uint64_t, uint64_t) { }));
+        }
+
+        return reader.is_valid();
+    };
+
+    EXPECT_TRUE(is_valid(file));
+    EXPECT_FALSE(is_valid({}));
+    EXPECT_FALSE(is_valid(std::vector<uint64_t>(file.begin(),
+                                                file.begin() + 10)));
+
+    // Truncated and extended
+    EXPECT_FALSE(is_valid(std::vector<uint64_t>(file.begin(),
+                                                file.end() - 1)));
+    auto extended = file;
+    extended.insert(extended.end() - 3, 0);
+    EXPECT_FALSE(is_valid(extended));
+
+    auto corrupt = [&file](uint64_t index, uint64_t value)
+    {
+        auto words = file;
+        words[index] = value;
+        return words;
+    };
+
+    const uint64_t trailer = file.size() - 3;
+
+    EXPECT_FALSE(is_valid(corrupt(0, 0x1234)));
+    EXPECT_FALSE(is_valid(corrupt(trailer + 2, 0x1234)));
+
+    // Another layout
+    EXPECT_FALSE(is_valid(corrupt(2, 2)));
+    EXPECT_FALSE(is_valid(corrupt(3, 63)));
+
+    // Records, blocks and block sizes not matching the file
+    EXPECT_FALSE(is_valid(corrupt(1, 0)));
+    EXPECT_FALSE(is_valid(corrupt(1, 101)));
+    EXPECT_FALSE(is_valid(corrupt(1, ~uint64_t{0})));
+    EXPECT_FALSE(is_valid(corrupt(trailer, 1001)));
+    EXPECT_FALSE(is_valid(corrupt(trailer + 1, 11)));
+    EXPECT_FALSE(is_valid(corrupt(trailer + 1, ~uint64_t{0})));
+    EXPECT_TRUE(is_valid(corrupt(trailer, 901)));
+
+    // The empty file
+    std::vector<uint64_t> empty;
+    bitter::block_file_writer<record> empty_writer(
+        bitter::vector_sink(empty), 100);
+    empty_writer.finish();
+    EXPECT_TRUE(is_valid(empty));
+}
@@ -0,0 +1,102 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/block_file_writer.hpp>
+#include <bitter/lsb0_layout.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_block_file_writer, format)
+{
+    using record = bitter::lsb0_layout<uint16_t, 4, 12>;
+
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<record> writer(bitter::vector_sink(file), 3);
+
+    for (uint16_t i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(writer.write(record::set<1>(record::set<0>(0, i),
+                                                100 - i)));
+    }
+
+    EXPECT_EQ(5U, writer.records());
+    EXPECT_EQ(1U, writer.blocks());
+
+    // The header and the first block are written as soon as it is full
+    EXPECT_EQ(8U + 2U, file.size());
+
+    EXPECT_TRUE(writer.finish());
+    EXPECT_EQ(2U, writer.blocks());
+
+    // Header, 2 blocks of a 1 word column per field, 2 blocks of 2 zone
+    // maps and the trailer
+    ASSERT_EQ(8U + 4U + 8U + 3U, file.size());
+
+    EXPECT_EQ(0x3130534B434F4C42U, file[0]);
+    EXPECT_EQ(3U, file[1]);
+    EXPECT_EQ(2U, file[2]);
+    EXPECT_EQ(16U, file[3]);
+
+    // The columns of block 0 and 1
+    EXPECT_EQ(0x210U, file[8]);
+    EXPECT_EQ((98U << 24) | (99U << 12) | 100U, file[9]);
+    EXPECT_EQ(0x43U, file[10]);
+    EXPECT_EQ((96U << 12) | 97U, file[11]);
+
+    // Zone maps of block 0 and 1
+    EXPECT_EQ(std::vector<uint64_t>({ 0, 2, 98, 100, 3, 4, 96, 97 }),
+              std::vector<uint64_t>(file.begin() + 12, file.begin() + 20));
+
+    // The trailer
+    EXPECT_EQ(5U, file[20]);
+    EXPECT_EQ(2U, file[21]);
+    EXPECT_EQ(0x3130534B434F4C42U, file[22]);
+}
+
+TEST(test_block_file_writer, empty)
+{
+    std::vector<uint64_t> file;
+    bitter::block_file_writer<bitter::lsb0_layout<uint8_t, 8>> writer(
+        bitter::vector_sink{file});
+
+    EXPECT_TRUE(writer.finish());
+    ASSERT_EQ(8U + 3U, file.size());
+    EXPECT_EQ(0U, file[8]);
+    EXPECT_EQ(0U, file[9]);
+}
+
+TEST(test_block_file_writer, callback_sink)
+{
+    using record = bitter::lsb0_layout<uint32_t, 16, 16>;
+
+    std::vector<uint64_t> sizes;
+    bool full = false;
+
+    auto sink = bitter::make_callback_sink(
+        [&sizes, &full](const void* data, uint64_t size)
+    {
+        EXPECT_NE(nullptr, data);
+        sizes.push_back(size);
+        return !full;
+    });
+
+    bitter::block_file_writer<record, decltype(sink)> writer(sink, 64);
+
+    std::vector<uint32_t> records(200, 0x12345678);
+    EXPECT_TRUE(writer.write(records.data(), records.size()));
+
+    // The header and 3 blocks of 2 columns of 16 words
+    EXPECT_EQ(std::vector<uint64_t>({ 64, 256, 256, 256 }), sizes);
+
+    // Once the sink fails the writer stops writing
+    full = true;
+    EXPECT_FALSE(writer.write(records.data(), records.size()));
+    EXPECT_EQ(5U, sizes.size());
+    EXPECT_FALSE(writer.finish());
+    EXPECT_EQ(5U, sizes.size());
+}
@@ -0,0 +1,132 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/c_bitfield_layout.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// As declared in C, id does not fit in the first 16 bit unit
+struct c_header
+{
+    uint16_t version : 4;
+    uint16_t type : 10;
+    uint16_t id : 12;
+};
+
+// The same with the bits the compiler skips as named members
+struct c_header_padded
+{
+    uint16_t version : 4;
+    uint16_t type : 10;
+    uint16_t padding0 : 2;
+    uint16_t id : 12;
+    uint16_t padding1 : 4;
+};
+
+using header = bitter::c_bitfield_layout<uint32_t, uint16_t, 4, 10, 2, 12, 4>;
+
+// The members in another order than the fields
+struct c_swapped
+{
+    uint16_t type : 10;
+    uint16_t version : 4;
+    uint16_t padding0 : 2;
+    uint16_t id : 12;
+    uint16_t padding1 : 4;
+};
+
+struct c_flags
+{
+    uint64_t valid : 1;
+    uint64_t dirty : 1;
+    uint64_t owner : 14;
+    uint64_t address : 48;
+};
+
+using flags = bitter::c_bitfield_layout<uint64_t, uint64_t, 1, 1, 14, 48>;
+
+static_assert(bitter::detail::is_within_units<16, 4, 10, 2, 12, 4>(), "");
+static_assert(!bitter::detail::is_within_units<16, 4, 10, 12, 6>(), "");
+static_assert(!bitter::detail::is_within_units<8, 4, 0, 4>(), "");
+
+#if defined(BITTER_HAS_CONSTEXPR_BIT_CAST)
+static_assert(header::matches<c_header_padded>(), "");
+static_assert(!header::matches<c_swapped>(), "");
+static_assert(flags::matches<c_flags>(), "");
+#endif
+}
+
+TEST(test_c_bitfield_layout, matches)
+{
+    EXPECT_TRUE(header::matches<c_header_padded>());
+    EXPECT_FALSE(header::matches<c_swapped>());
+    EXPECT_TRUE(flags::matches<c_flags>());
+}
+
+TEST(test_c_bitfield_layout, from_to_struct)
+{
+    c_header h;
+    h.version = 0x3;
+    h.type = 0x2A5;
+    h.id = 0xABC;
+
+    uint32_t value = header::from_struct(h);
+
+    EXPECT_EQ(0x3U, header::get<0>(value));
+    EXPECT_EQ(0x2A5U, header::get<1>(value));
+    EXPECT_EQ(0xABCU, header::get<3>(value));
+
+    value = header::set<1>(value, 0x11);
+    c_header back = header::to_struct<c_header>(value);
+
+    EXPECT_EQ(0x3U, back.version);
+    EXPECT_EQ(0x11U, back.type);
+    EXPECT_EQ(0xABCU, back.id);
+
+    c_flags f = flags::to_struct<c_flags>(flags::set<3>(
+        flags::set<0>(0, 1), 0x7FFF12345678U));
+
+    EXPECT_EQ(1U, f.valid);
+    EXPECT_EQ(0U, f.dirty);
+    EXPECT_EQ(0x7FFF12345678U, f.address);
+}
+
+TEST(test_c_bitfield_layout, bulk)
+{
+    std::vector<c_header> headers(100);
+
+    for (uint16_t i = 0; i < headers.size(); ++i)
+    {
+        headers[i].version = i % 16;
+        headers[i].type = i * 7;
+        headers[i].id = i * 31;
+    }
+
+    std::vector<uint32_t> values(headers.size());
+    header::from_structs(headers.data(), headers.size(), values.data());
+
+    for (uint16_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(i % 16U, header::get<0>(values[i]));
+        EXPECT_EQ(i * 7U, header::get<1>(values[i]));
+        EXPECT_EQ(i * 31U, header::get<3>(values[i]));
+        values[i] = header::set<3>(values[i], i);
+    }
+
+    header::to_structs(values.data(), values.size(), headers.data());
+
+    for (uint16_t i = 0; i < headers.size(); ++i)
+    {
+        EXPECT_EQ(i, headers[i].id);
+        EXPECT_EQ(i * 7U, headers[i].type);
+    }
+
+    header::from_structs<c_header>(nullptr, 0, nullptr);
+}
@@ -0,0 +1,141 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/changed_fields.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Compares every field with the runtime field table
+template<class Layout>
+uint64_t changed_reference(typename Layout::value_type a,
+                           typename Layout::value_type b)
+{
+    uint64_t changed = 0;
+
+    for (uint32_t i = 0; i < Layout::fields; ++i)
+    {
+        if (Layout::table::get(a, i) != Layout::table::get(b, i))
+        {
+            changed |= uint64_t{1} << i;
+        }
+    }
+
+    return changed;
+}
+
+template<class Layout>
+void check_random()
+{
+    using value_type = typename Layout::value_type;
+    const uint64_t all = Layout::bits == 64 ? ~uint64_t{0} :
+                         (uint64_t{1} << Layout::bits) - 1;
+
+    std::vector<value_type> previous(500);
+    std::vector<value_type> current(500);
+
+    for (uint32_t i = 0; i < previous.size(); ++i)
+    {
+        uint64_t value = (uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^
+                         rand();
+        previous[i] = static_cast<value_type>(value & all);
+
+        // Flip a single bit or a few
+        uint64_t flip = i % 2 ? uint64_t{1} << (rand() % Layout::bits) :
+                        uint64_t(rand()) & all;
+        current[i] = static_cast<value_type>(previous[i] ^ flip);
+    }
+
+    std::vector<uint64_t> changed(previous.size());
+    bitter::changed_fields<Layout>(previous.data(), current.data(),
+                                   previous.size(), changed.data());
+
+    for (uint32_t i = 0; i < previous.size(); ++i)
+    {
+        ASSERT_EQ((changed_reference<Layout>(previous[i], current[i])),
+                  changed[i]);
+    }
+}
+}
+
+TEST(test_changed_fields, lsb0)
+{
+    using state = bitter::lsb0_layout<uint32_t, 1, 7, 8, 16>;
+
+    uint32_t previous = 0;
+    uint32_t current = state::set<2>(previous, 0x80);
+
+    EXPECT_EQ(0x4U, bitter::changed_fields<state>(previous, current));
+    EXPECT_EQ(0x0U, bitter::changed_fields<state>(current, current));
+
+    current = state::set<0>(current, 1);
+    current = state::set<3>(current, 0x1);
+    EXPECT_EQ(0xDU, bitter::changed_fields<state>(previous, current));
+}
+
+TEST(test_changed_fields, msb0)
+{
+    using state = bitter::msb0_layout<uint16_t, 3, 1, 12>;
+
+    uint16_t previous = 0x1234;
+    uint16_t current = state::set<0>(previous, 0x7);
+
+    EXPECT_EQ(0x1U, bitter::changed_fields<state>(previous, current));
+
+    current = state::set<2>(previous, 0x235);
+    EXPECT_EQ(0x4U, bitter::changed_fields<state>(previous, current));
+}
+
+TEST(test_changed_fields, random)
+{
+    check_random<bitter::lsb0_layout<uint8_t, 1, 1, 1, 1, 1, 1, 1, 1>>();
+    check_random<bitter::lsb0_layout<uint32_t, 1, 7, 8, 16>>();
+    check_random<bitter::msb0_layout<uint32_t, 1, 7, 8, 16>>();
+    check_random<bitter::lsb0_layout<bitter::u24, 5, 9, 10>>();
+    check_random<bitter::msb0_layout<uint64_t, 2, 30, 31, 1>>();
+    check_random<bitter::lsb0_layout<uint64_t, 64>>();
+    check_random<bitter::msb0_layout<uint64_t, 4, 4, 4, 4, 4, 4, 4, 4,
+                                     4, 4, 4, 4, 4, 4, 4, 4>>();
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_changed_fields, wide)
+{
+    // Layouts above 64 bits are checked one field at a time
+    using lsb0_state = bitter::lsb0_layout<bitter::u128, 32, 32, 32, 32>;
+    using msb0_state = bitter::msb0_layout<bitter::u128, 64, 16, 24, 24>;
+
+    bitter::uint128_t previous = (bitter::uint128_t(0x0123456789ABCDEFU) << 64) |
+                                 0x0011223344556677U;
+
+    bitter::uint128_t current = lsb0_state::set<3>(previous, 0x1);
+    EXPECT_EQ(0x8U, bitter::changed_fields<lsb0_state>(previous, current));
+
+    current = lsb0_state::set<0>(current, 0x0);
+    EXPECT_EQ(0x9U, bitter::changed_fields<lsb0_state>(previous, current));
+    EXPECT_EQ(0x0U, bitter::changed_fields<lsb0_state>(current, current));
+
+    current = msb0_state::set<0>(previous, 0x1);
+    EXPECT_EQ(0x1U, bitter::changed_fields<msb0_state>(previous, current));
+
+    // A single flipped bit changes the field holding it
+    for (uint32_t bit = 0; bit < 128; ++bit)
+    {
+        current = previous ^ (bitter::uint128_t(1) << bit);
+
+        EXPECT_EQ((changed_reference<lsb0_state>(previous, current)),
+                  bitter::changed_fields<lsb0_state>(previous, current));
+        EXPECT_EQ((changed_reference<msb0_state>(previous, current)),
+                  bitter::changed_fields<msb0_state>(previous, current));
+    }
+}
+#endif
@@ -0,0 +1,131 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/copy_bits.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+bool get_bit(const std::vector<uint8_t>& data, uint64_t bit, bool msb0)
+{
+    uint32_t shift = msb0 ? 7 - bit % 8 : bit % 8;
+    return (data[bit / 8] >> shift) & 1U;
+}
+
+void set_bit(std::vector<uint8_t>& data, uint64_t bit, bool msb0, bool value)
+{
+    uint32_t shift = msb0 ? 7 - bit % 8 : bit % 8;
+    data[bit / 8] = static_cast<uint8_t>(
+        (data[bit / 8] & ~(1U << shift)) | (uint32_t(value) << shift));
+}
+
+std::vector<uint8_t> random_bytes(uint64_t size)
+{
+    std::vector<uint8_t> data(size);
+
+    for (auto& byte : data)
+    {
+        byte = static_cast<uint8_t>(rand());
+    }
+
+    return data;
+}
+
+template<class BitNumbering>
+void check(bool msb0, uint64_t max_bits)
+{
+    auto source = random_bytes(max_bits / 8 + 3);
+    auto original = random_bytes(max_bits / 8 + 3);
+
+    for (uint64_t source_offset = 0; source_offset < 16; ++source_offset)
+    {
+        for (uint64_t destination_offset = 0; destination_offset < 16;
+             ++destination_offset)
+        {
+            for (uint64_t bits = 0; bits + 16 <= max_bits; ++bits)
+            {
+                // Only give access to the bytes of the ranges, to catch
+                // reads and writes outside them with the sanitizers
+                uint64_t first = destination_offset / 8;
+                uint64_t last = (destination_offset + bits + 7) / 8;
+
+                std::vector<uint8_t> destination(
+                    original.begin() + first, original.begin() + last);
+                std::vector<uint8_t> range(
+                    source.begin() + source_offset / 8,
+                    source.begin() + (source_offset + bits + 7) / 8);
+
+                std::vector<uint8_t> expected(destination);
+
+                for (uint64_t i = 0; i < bits; ++i)
+                {
+                    set_bit(expected, destination_offset % 8 + i, msb0,
+                            get_bit(source, source_offset + i, msb0));
+                }
+
+                bitter::copy_bits<BitNumbering>(
+                    destination.data(), destination_offset % 8,
+                    range.data(), source_offset % 8, bits);
+
+                ASSERT_EQ(expected, destination)
+                    << source_offset << " " << destination_offset << " "
+                    << bits;
+            }
+        }
+    }
+}
+}
+
+TEST(test_copy_bits, msb0)
+{
+    std::vector<uint8_t> source = { 0xAB, 0xCD };
+    std::vector<uint8_t> destination = { 0x00, 0x00 };
+
+    // Bits 4 to 11 of the source (0xBC) to bits 2 to 9
+    bitter::copy_bits<bitter::msb0>(destination.data(), 2, source.data(), 4, 8);
+    EXPECT_EQ(0x2F, destination[0]);
+    EXPECT_EQ(0x00, destination[1]);
+
+    check<bitter::msb0>(true, 200);
+}
+
+TEST(test_copy_bits, lsb0)
+{
+    std::vector<uint8_t> source = { 0xAB, 0xCD };
+    std::vector<uint8_t> destination = { 0xFF, 0xFF };
+
+    // Bits 4 to 11 of the source (0xDA) to bits 2 to 9
+    bitter::copy_bits<bitter::lsb0>(destination.data(), 2, source.data(), 4, 8);
+    EXPECT_EQ(0x6B, destination[0]);
+    EXPECT_EQ(0xFF, destination[1]);
+
+    check<bitter::lsb0>(false, 200);
+}
+
+TEST(test_copy_bits, long_runs)
+{
+    auto source = random_bytes(4099);
+
+    for (uint64_t offset : { 0, 3, 8, 13 })
+    {
+        std::vector<uint8_t> msb0(4100, 0);
+        std::vector<uint8_t> lsb0(4100, 0);
+        uint64_t bits = 4096 * 8 - 5;
+
+        bitter::copy_bits<bitter::msb0>(msb0.data(), 5, source.data(), offset, bits);
+        bitter::copy_bits<bitter::lsb0>(lsb0.data(), 5, source.data(), offset, bits);
+
+        for (uint64_t i = 0; i < bits; ++i)
+        {
+            ASSERT_EQ(get_bit(source, offset + i, true), get_bit(msb0, 5 + i, true));
+            ASSERT_EQ(get_bit(source, offset + i, false), get_bit(lsb0, 5 + i, false));
+        }
+    }
+}
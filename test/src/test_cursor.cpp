@@ -0,0 +1,232 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/cursor.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// The ether type following the destination and source MAC
+using ether_type = bitter::msb0_layout<uint16_t, 16>;
+
+// Priority, drop eligible, VLAN id and the next ether type
+using vlan = bitter::msb0_layout<uint32_t, 3, 1, 12, 16>;
+
+// Version, IHL, type of service and total length
+using ipv4 = bitter::msb0_layout<uint32_t, 4, 4, 8, 16>;
+
+// TTL, protocol and checksum after the identification, flags and
+// fragment offset
+using ipv4_protocol = bitter::msb0_layout<uint64_t, 16, 3, 13, 8, 8, 16>;
+
+// Source port, destination port, length and checksum
+using udp = bitter::msb0_layout<uint64_t, 16, 16, 16, 16>;
+
+std::vector<uint8_t> make_packet(uint32_t ip_options)
+{
+    std::vector<uint8_t> packet =
+    {
+        // Ethernet
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA,
+        0xBB, 0x81, 0x00,
+        // VLAN with priority 5 and id 42
+        0xA0, 0x2A, 0x08, 0x00,
+        // IPv4
+        uint8_t(0x45 + ip_options), 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+        0x00, 0x40, 0x11, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x01, 0x0A, 0x00,
+        0x00, 0x02
+    };
+
+    packet.insert(packet.end(), ip_options * 4, 0x01);
+
+    // UDP from port 1234 to 5678 with 4 bytes of payload
+    std::vector<uint8_t> udp_header =
+    {
+        0x04, 0xD2, 0x16, 0x2E, 0x00, 0x0C, 0x00, 0x00,
+        0xDE, 0xAD, 0xBE, 0xEF
+    };
+
+    packet.insert(packet.end(), udp_header.begin(), udp_header.end());
+    return packet;
+}
+
+// Parses the header chain, returns the payload or false if the packet is
+// not a VLAN tagged UDP packet or truncated
+bool parse(const std::vector<uint8_t>& packet, uint32_t& vlan_id,
+           uint32_t& port, bitter::cursor& payload)
+{
+    bitter::cursor cursor(packet.data(), packet.size());
+
+    ether_type::value_type type;
+    vlan::value_type tag;
+    ipv4::value_type ip;
+    ipv4_protocol::value_type protocol;
+    udp::value_type header;
+
+    if (!cursor.skip(12) || !cursor.read<ether_type>(type) ||
+        ether_type::get<0>(type) != 0x8100)
+    {
+        return false;
+    }
+
+    if (!cursor.read<vlan>(tag) || vlan::get<3>(tag) != 0x0800)
+    {
+        return false;
+    }
+
+    vlan_id = vlan::get<2>(tag);
+
+    if (!cursor.peek<ipv4>(ip) || ipv4::get<1>(ip) < 5)
+    {
+        return false;
+    }
+
+    bitter::cursor ip_header(nullptr, 0);
+
+    if (!cursor.split(ipv4::get<1>(ip) * 4, ip_header) ||
+        !ip_header.skip(4) || !ip_header.read<ipv4_protocol>(protocol) ||
+        ipv4_protocol::get<4>(protocol) != 17)
+    {
+        return false;
+    }
+
+    if (!cursor.read<udp>(header) || udp::get<2>(header) < 8)
+    {
+        return false;
+    }
+
+    port = udp::get<1>(header);
+    return cursor.split(udp::get<2>(header) - 8, payload);
+}
+}
+
+TEST(test_cursor, read)
+{
+    std::vector<uint8_t> data = { 0x12, 0x34, 0x56, 0x78, 0x9A };
+    bitter::cursor cursor(data.data(), data.size());
+
+    EXPECT_EQ(0U, cursor.position());
+    EXPECT_EQ(5U, cursor.remaining());
+    EXPECT_EQ(4U, cursor.size<ipv4>());
+
+    // MSB 0 layouts are loaded in big endian
+    bitter::msb0_layout<uint16_t, 4, 12>::value_type big = 0;
+    EXPECT_TRUE((cursor.peek<bitter::msb0_layout<uint16_t, 4, 12>>(big)));
+    EXPECT_EQ(0x1234U, big);
+    EXPECT_EQ(0U, cursor.position());
+
+    // LSB 0 layouts in little endian
+    using little = bitter::lsb0_layout<bitter::u24, 8, 16>;
+    little::value_type value = 0;
+    EXPECT_TRUE(cursor.read<little>(value));
+    EXPECT_EQ(0x563412U, value);
+    EXPECT_EQ(0x5634U, little::get<1>(value));
+    EXPECT_EQ(3U, cursor.position());
+    EXPECT_EQ(data.data() + 3, cursor.data());
+
+    // Too short, nothing changes
+    EXPECT_FALSE(cursor.read<little>(value));
+    EXPECT_EQ(0x563412U, value);
+    EXPECT_EQ(3U, cursor.position());
+
+    EXPECT_FALSE(cursor.skip(3));
+    EXPECT_TRUE(cursor.skip(2));
+    EXPECT_TRUE(cursor.empty());
+    EXPECT_TRUE(cursor.skip(0));
+
+    cursor.prefetch();
+    cursor.prefetch(100);
+}
+
+TEST(test_cursor, split)
+{
+    std::vector<uint8_t> data = { 3, 0xA, 0xB, 0xC, 1, 0xD };
+    bitter::cursor cursor(data.data(), data.size());
+
+    // Records of a length byte followed by the data
+    using length = bitter::msb0_layout<uint8_t, 8>;
+    std::vector<uint64_t> sizes;
+    length::value_type size;
+
+    while (cursor.read<length>(size))
+    {
+        bitter::cursor record(nullptr, 0);
+        ASSERT_TRUE(cursor.split(size, record));
+        EXPECT_EQ(size, record.remaining());
+        sizes.push_back(record.remaining());
+    }
+
+    EXPECT_EQ(std::vector<uint64_t>({ 3, 1 }), sizes);
+
+    bitter::cursor record(nullptr, 0);
+    EXPECT_FALSE(cursor.split(1, record));
+    EXPECT_TRUE(record.empty());
+}
+
+TEST(test_cursor, header_chain)
+{
+    for (uint32_t options : { 0, 2 })
+    {
+        auto packet = make_packet(options);
+
+        uint32_t vlan_id = 0;
+        uint32_t port = 0;
+        bitter::cursor payload(nullptr, 0);
+
+        ASSERT_TRUE(parse(packet, vlan_id, port, payload));
+        EXPECT_EQ(42U, vlan_id);
+        EXPECT_EQ(5678U, port);
+        EXPECT_EQ(4U, payload.remaining());
+        EXPECT_EQ(0xDE, payload.data()[0]);
+
+        // Every truncation is detected
+        for (uint64_t size = 0; size < packet.size(); ++size)
+        {
+            std::vector<uint8_t> truncated(packet.begin(),
+                                           packet.begin() + size);
+
+            EXPECT_FALSE(parse(truncated, vlan_id, port, payload));
+        }
+    }
+}
+
+TEST(test_cursor, batch)
+{
+    // Fixed size records parsed while prefetching the next one
+    using record = bitter::msb0_layout<uint32_t, 8, 24>;
+
+    std::vector<uint8_t> data;
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        data.insert(data.end(), { uint8_t(i), 0x00, 0x00, uint8_t(i) });
+    }
+
+    bitter::cursor cursor(data.data(), data.size());
+    record::value_type value;
+    uint32_t count = 0;
+
+    while (true)
+    {
+        cursor.prefetch(bitter::cursor::size<record>() * 8);
+
+        if (!cursor.read<record>(value))
+        {
+            break;
+        }
+
+        EXPECT_EQ(count, record::get<0>(value));
+        EXPECT_EQ(count, record::get<1>(value));
+        ++count;
+    }
+
+    EXPECT_EQ(100U, count);
+}
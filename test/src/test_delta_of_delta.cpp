@@ -0,0 +1,133 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/delta_of_delta.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Timestamp in ms, sequence number, state and a temperature
+using sample = bitter::lsb0_layout<uint64_t, 32, 16, 4, 12>;
+
+template<class Layout, class BitNumbering>
+uint64_t check(const std::vector<typename Layout::value_type>& values)
+{
+    std::vector<uint8_t> data(values.size() * Layout::bits + 64);
+
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+    bitter::delta_of_delta_encoder<Layout, BitNumbering> encoder(writer);
+    encoder.encode(values.data(), values.size());
+    writer.flush();
+
+    bitter::bit_stream_reader<BitNumbering> reader(data.data(), writer.size());
+    bitter::delta_of_delta_decoder<Layout, BitNumbering> decoder(reader);
+
+    std::vector<typename Layout::value_type> decoded(values.size());
+    decoder.decode(decoded.data(), decoded.size());
+    EXPECT_EQ(values, decoded);
+
+    return writer.size();
+}
+}
+
+TEST(test_delta_of_delta, constant_rate)
+{
+    std::vector<uint64_t> values;
+
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        uint64_t value = sample::set<0>(0, 1000000 + i * 250);
+        value = sample::set<1>(value, (i * 3) & 0xFFFF);
+        value = sample::set<2>(value, 5);
+        value = sample::set<3>(value, 2048);
+        values.push_back(value);
+    }
+
+    uint64_t bytes = check<sample, bitter::msb0>(values);
+
+    // After the first two samples every field takes a single bit
+    EXPECT_LT(bytes, 1000U * 4 / 8 + 32);
+}
+
+TEST(test_delta_of_delta, wrap_around)
+{
+    using counter = bitter::msb0_layout<uint16_t, 4, 12>;
+
+    std::vector<uint16_t> values;
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        values.push_back(counter::set<1>(counter::set<0>(0, (i * 7) % 16),
+                                         (4000 + i * 50) % 4096));
+    }
+
+    check<counter, bitter::msb0>(values);
+    check<counter, bitter::lsb0>(values);
+}
+
+TEST(test_delta_of_delta, random)
+{
+    std::vector<uint64_t> values(1000);
+
+    for (auto& value : values)
+    {
+        value = (uint64_t(rand()) << 32) ^ uint64_t(rand());
+    }
+
+    check<sample, bitter::lsb0>(values);
+
+    using wide = bitter::lsb0_layout<uint64_t, 63, 1>;
+    check<wide, bitter::msb0>(values);
+}
+
+TEST(test_delta_of_delta, truncated)
+{
+    std::vector<uint64_t> values;
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        values.push_back(sample::set<0>(0, 1000 + 10 * i * i));
+    }
+
+    std::vector<uint8_t> data(values.size() * sample::bits);
+
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+    bitter::delta_of_delta_encoder<sample, bitter::msb0> encoder(writer);
+    encoder.encode(values.data(), values.size());
+    writer.flush();
+
+    // Half the stream decodes to the first values and then stops
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(),
+                                                   writer.size() / 2);
+    bitter::delta_of_delta_decoder<sample, bitter::msb0> decoder(reader);
+
+    std::vector<uint64_t> decoded(values.size());
+    uint64_t count = decoder.decode(decoded.data(), decoded.size());
+
+    EXPECT_GT(count, 0U);
+    EXPECT_LT(count, values.size());
+    EXPECT_FALSE(reader.is_valid());
+
+    decoded.resize(count);
+    values.resize(count);
+    EXPECT_EQ(values, decoded);
+
+    // All zero data is a prefix running past the end
+    std::vector<uint8_t> zeros(8, 0);
+    bitter::bit_stream_reader<bitter::msb0> zero_reader(zeros.data(),
+                                                        zeros.size());
+    bitter::delta_of_delta_decoder<sample, bitter::msb0> zero_decoder(
+        zero_reader);
+
+    EXPECT_EQ(0U, zero_decoder.decode(decoded.data(), decoded.size()));
+    EXPECT_FALSE(zero_reader.is_valid());
+}
@@ -0,0 +1,106 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/elias_fano.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<uint64_t> random_sequence(uint64_t count, uint64_t max_gap)
+{
+    std::vector<uint64_t> values(count);
+    uint64_t value = rand() % (max_gap + 1);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        values[i] = value;
+        value += rand() % (max_gap + 1);
+    }
+
+    return values;
+}
+
+void check(const std::vector<uint64_t>& values)
+{
+    bitter::elias_fano sequence(values.data(), values.size());
+    ASSERT_EQ(values.size(), sequence.size());
+
+    for (uint64_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(values[i], sequence.at(i));
+    }
+
+    std::vector<uint64_t> decoded(values.size());
+    sequence.decode(0, values.size(), decoded.data());
+    EXPECT_EQ(values, decoded);
+
+    if (values.size() > 10)
+    {
+        std::vector<uint64_t> part(5);
+        sequence.decode(7, 5, part.data());
+        EXPECT_TRUE(std::equal(part.begin(), part.end(), values.begin() + 7));
+    }
+
+    uint64_t last = values.empty() ? 0 : values.back();
+
+    for (uint64_t value = 0; value <= last + 2; value += 1 + last / 1000)
+    {
+        uint64_t expected = std::lower_bound(
+            values.begin(), values.end(), value) - values.begin();
+
+        ASSERT_EQ(expected, sequence.next_geq(value));
+    }
+}
+}
+
+TEST(test_elias_fano, small)
+{
+    std::vector<uint64_t> values = { 2, 3, 5, 7, 11, 13, 24 };
+    bitter::elias_fano sequence(values.data(), values.size());
+
+    EXPECT_EQ(1U, sequence.low_bits());
+    EXPECT_EQ(11U, sequence.at(4));
+    EXPECT_EQ(0U, sequence.next_geq(0));
+    EXPECT_EQ(4U, sequence.next_geq(8));
+    EXPECT_EQ(6U, sequence.next_geq(24));
+    EXPECT_EQ(7U, sequence.next_geq(25));
+
+    check(values);
+}
+
+TEST(test_elias_fano, duplicates)
+{
+    check({ 0, 0, 0, 5, 5, 9, 9, 9, 9, 100 });
+    check({ 7, 7, 7, 7 });
+}
+
+TEST(test_elias_fano, empty)
+{
+    check({});
+}
+
+TEST(test_elias_fano, random)
+{
+    check(random_sequence(1000, 1));
+    check(random_sequence(1000, 10));
+    check(random_sequence(10000, 1000));
+    check(random_sequence(100, 1000000));
+}
+
+TEST(test_elias_fano, compression)
+{
+    // Offsets with an average distance of 4096
+    auto values = random_sequence(100000, 8192);
+    bitter::elias_fano sequence(values.data(), values.size());
+
+    // 12 low bits, ~2 high bits and the rank/select index
+    EXPECT_LT(sequence.size_in_bits(), values.size() * 15);
+}
@@ -0,0 +1,184 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/exp_golomb.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_exp_golomb, encode)
+{
+    std::vector<uint8_t> data(4, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+
+    // 1 010 011 00100 = 1010 0110 0100 ...
+    bitter::exp_golomb_encode(writer, 0);
+    bitter::exp_golomb_encode(writer, 1);
+    bitter::exp_golomb_encode(writer, 2);
+    bitter::exp_golomb_encode(writer, 3);
+    EXPECT_EQ(12U, writer.bits_written());
+    writer.flush();
+
+    EXPECT_EQ(0xA6U, data[0]);
+    EXPECT_EQ(0x40U, data[1]);
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), 2);
+    EXPECT_EQ(0U, bitter::exp_golomb_decode(reader));
+    EXPECT_EQ(1U, bitter::exp_golomb_decode(reader));
+    EXPECT_EQ(2U, bitter::exp_golomb_decode(reader));
+    EXPECT_EQ(3U, bitter::exp_golomb_decode(reader));
+}
+
+TEST(test_exp_golomb, signed)
+{
+    std::vector<uint8_t> data(512, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+
+    // se(v): 0 -> 1, 1 -> 010, -1 -> 011
+    bitter::exp_golomb_encode_signed(writer, 0);
+    bitter::exp_golomb_encode_signed(writer, 1);
+    bitter::exp_golomb_encode_signed(writer, -1);
+    writer.flush();
+
+    EXPECT_EQ(0xA6U, data[0]);
+
+    for (int64_t value = -100; value <= 100; ++value)
+    {
+        bitter::exp_golomb_encode_signed(writer, value);
+    }
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+    EXPECT_EQ(0, bitter::exp_golomb_decode_signed(reader));
+    EXPECT_EQ(1, bitter::exp_golomb_decode_signed(reader));
+    EXPECT_EQ(-1, bitter::exp_golomb_decode_signed(reader));
+
+    // Skip the bit padding the first byte
+    reader.read(1);
+
+    for (int64_t value = -100; value <= 100; ++value)
+    {
+        EXPECT_EQ(value, bitter::exp_golomb_decode_signed(reader));
+    }
+}
+
+TEST(test_exp_golomb, limits)
+{
+    std::vector<uint8_t> data(128, 0);
+    bitter::bit_stream_writer<bitter::lsb0> writer(data.data(), data.size());
+
+    const int64_t min = std::numeric_limits<int64_t>::min();
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    const uint64_t top = ~uint64_t{0};
+
+    // INT64_MIN maps to 2^64 - 1 whose code has 64 zeros
+    bitter::exp_golomb_encode_signed(writer, min);
+    bitter::exp_golomb_encode_signed(writer, max);
+    bitter::exp_golomb_encode_signed(writer, min + 1);
+    bitter::exp_golomb_encode(writer, top);
+    bitter::exp_golomb_encode(writer, top, 5);
+    bitter::exp_golomb_encode(writer, top - 31, 5);
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::lsb0> reader(data.data(), data.size());
+    EXPECT_EQ(min, bitter::exp_golomb_decode_signed(reader));
+    EXPECT_EQ(max, bitter::exp_golomb_decode_signed(reader));
+    EXPECT_EQ(min + 1, bitter::exp_golomb_decode_signed(reader));
+    EXPECT_EQ(top, bitter::exp_golomb_decode(reader));
+    EXPECT_EQ(top, bitter::exp_golomb_decode(reader, 5));
+    EXPECT_EQ(top - 31, bitter::exp_golomb_decode(reader, 5));
+}
+
+TEST(test_exp_golomb, truncated)
+{
+    // All zero data is a prefix running past the end
+    std::vector<uint8_t> zeros(4, 0);
+    std::vector<uint64_t> values(4);
+
+    bitter::bit_stream_reader<bitter::msb0> reader(zeros.data(), zeros.size());
+    EXPECT_EQ(0U, bitter::exp_golomb_decode(reader));
+    EXPECT_FALSE(reader.is_valid());
+
+    bitter::bit_stream_reader<bitter::lsb0> bulk(zeros.data(), zeros.size());
+    EXPECT_EQ(0U, bitter::exp_golomb_decode(bulk, values.data(),
+                                            values.size()));
+    EXPECT_FALSE(bulk.is_valid());
+
+    // A prefix of 65 zeros is longer than any 64 bit value
+    std::vector<uint8_t> long_prefix(16, 0);
+    long_prefix[8] = 0x40;
+
+    bitter::bit_stream_reader<bitter::msb0> invalid(long_prefix.data(),
+                                                    long_prefix.size());
+    EXPECT_EQ(0U, bitter::exp_golomb_decode(invalid));
+    EXPECT_FALSE(invalid.is_valid());
+
+    // A stream cut within the third value
+    std::vector<uint8_t> data(8, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+    bitter::exp_golomb_encode(writer, 3);
+    bitter::exp_golomb_encode(writer, 1000);
+    bitter::exp_golomb_encode(writer, 1000);
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::msb0> cut(data.data(), 4);
+    EXPECT_EQ(2U, bitter::exp_golomb_decode(cut, values.data(),
+                                            values.size()));
+    EXPECT_EQ(3U, values[0]);
+    EXPECT_EQ(1000U, values[1]);
+    EXPECT_FALSE(cut.is_valid());
+}
+
+template<class BitNumbering>
+void test_round_trip(uint32_t k)
+{
+    const uint32_t count = 1000;
+
+    std::vector<uint64_t> values(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint64_t value = (uint64_t(rand()) << 42) ^ (uint64_t(rand()) << 21) ^
+                         uint64_t(rand());
+        uint32_t bits = rand() % 63;
+        values[i] = i % 2 ? rand() % 16 : value & ((uint64_t{1} << bits) - 1);
+    }
+
+    std::vector<uint8_t> data(count * 16);
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+    bitter::exp_golomb_encode(writer, values.data(), count, k);
+    writer.flush();
+
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(values[i], bitter::exp_golomb_decode(reader, k));
+        }
+    }
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        std::vector<uint64_t> decoded(count);
+        bitter::exp_golomb_decode(reader, decoded.data(), count, k);
+        EXPECT_EQ(values, decoded);
+        EXPECT_LT(reader.bits_left(), 8U);
+    }
+}
+
+TEST(test_exp_golomb, round_trip)
+{
+    test_round_trip<bitter::msb0>(0);
+    test_round_trip<bitter::msb0>(3);
+    test_round_trip<bitter::lsb0>(0);
+    test_round_trip<bitter::lsb0>(5);
+}
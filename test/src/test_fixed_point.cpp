@@ -0,0 +1,132 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/fixed_point.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// A temperature, a signed acceleration and a status
+using frame = bitter::lsb0_layout<uint32_t, 12, 16, 4>;
+
+using temperature = bitter::fixed_point<frame, 0, std::ratio<1, 16>,
+                                        std::ratio<-40>>;
+
+using acceleration = bitter::fixed_point<frame, 1, std::ratio<1, 1000>,
+                                         std::ratio<0>, true>;
+}
+
+TEST(test_fixed_point, range)
+{
+    EXPECT_EQ(12U, temperature::bits);
+    EXPECT_EQ(0, temperature::raw_min);
+    EXPECT_EQ(4095, temperature::raw_max);
+    EXPECT_EQ(-32768, acceleration::raw_min);
+    EXPECT_EQ(32767, acceleration::raw_max);
+}
+
+TEST(test_fixed_point, to_float)
+{
+    EXPECT_FLOAT_EQ(-40.0f, temperature::to_float<float>(0));
+    EXPECT_FLOAT_EQ(-39.9375f, temperature::to_float<float>(1));
+    EXPECT_FLOAT_EQ(215.9375f, temperature::to_float<float>(4095));
+
+    EXPECT_DOUBLE_EQ(0.0, acceleration::to_float<double>(0));
+    EXPECT_DOUBLE_EQ(-0.001, acceleration::to_float<double>(0xFFFF));
+    EXPECT_DOUBLE_EQ(-32.768, acceleration::to_float<double>(0x8000));
+    EXPECT_DOUBLE_EQ(32.767, acceleration::to_float<double>(0x7FFF));
+}
+
+TEST(test_fixed_point, from_float)
+{
+    EXPECT_EQ(984U, temperature::from_float(21.5f));
+    EXPECT_EQ(985U, temperature::from_float(21.55f));
+    EXPECT_EQ(984U, temperature::from_float(21.52));
+
+    // Saturated to the range
+    EXPECT_EQ(0U, temperature::from_float(-100.0f));
+    EXPECT_EQ(4095U, temperature::from_float(1000.0f));
+
+    EXPECT_EQ(0xFFFFU, acceleration::from_float(-0.001));
+    EXPECT_EQ(0xFC18U, acceleration::from_float(-1.0));
+    EXPECT_EQ(0x8000U, acceleration::from_float(-50.0));
+    EXPECT_EQ(0x7FFFU, acceleration::from_float(50.0f));
+}
+
+TEST(test_fixed_point, get_set)
+{
+    uint32_t value = frame::set<2>(0, 0xA);
+    value = temperature::set(value, 21.5f);
+    value = acceleration::set(value, -9.81);
+
+    EXPECT_FLOAT_EQ(21.5f, temperature::get<float>(value));
+    EXPECT_DOUBLE_EQ(-9.81, acceleration::get<double>(value));
+    EXPECT_EQ(0xAU, frame::get<2>(value));
+
+    // MSB 0 with a fractional offset
+    using sample = bitter::msb0_layout<uint16_t, 10, 6>;
+    using voltage = bitter::fixed_point<sample, 0, std::ratio<1, 100>,
+                                        std::ratio<1, 2>>;
+
+    uint16_t raw = voltage::set<double>(0, 3.3);
+    EXPECT_EQ(280U, sample::get<0>(raw));
+    EXPECT_DOUBLE_EQ(3.3, voltage::get<double>(raw));
+}
+
+TEST(test_fixed_point, bulk)
+{
+    std::vector<uint32_t> values(1000);
+    std::vector<float> celsius(values.size());
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+        celsius[i] = -40.0f + i * 0.25f;
+    }
+
+    temperature::set(values.data(), values.size(), celsius.data());
+
+    std::vector<float> column(values.size());
+    temperature::get(values.data(), values.size(), column.data());
+
+    EXPECT_EQ(celsius, column);
+
+    std::vector<double> accelerations(values.size());
+    acceleration::get(values.data(), values.size(), accelerations.data());
+
+    for (double a : accelerations)
+    {
+        EXPECT_EQ(0.0, a);
+    }
+}
+
+TEST(test_fixed_point, nan)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // NaN is the raw value 0, infinities saturate
+    EXPECT_EQ(0U, temperature::from_float(nan));
+    EXPECT_EQ(0U, acceleration::from_float(-nan));
+    EXPECT_EQ(4095U, temperature::from_float(infinity));
+    EXPECT_EQ(0x8000U, acceleration::from_float(-infinity));
+
+    std::vector<uint32_t> values(3, frame::set<2>(0, 0xA));
+    std::vector<float> celsius = { 21.5f, nan, 100.0f };
+
+    temperature::set(values.data(), values.size(), celsius.data());
+
+    EXPECT_EQ(984U, frame::get<0>(values[0]));
+    EXPECT_EQ(0U, frame::get<0>(values[1]));
+    EXPECT_EQ(0xAU, frame::get<2>(values[1]));
+    EXPECT_EQ(2240U, frame::get<0>(values[2]));
+}
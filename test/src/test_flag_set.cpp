@@ -0,0 +1,124 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/flag_set.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+enum class tcp_flag
+{
+    ns, cwr, ece, urg, ack, psh, rst, syn, fin
+};
+
+// Data offset, reserved and the control bits of a TCP header
+using control = bitter::msb0_layout<uint16_t, 4, 3,
+      1, 1, 1, 1, 1, 1, 1, 1, 1>;
+
+using tcp_flags = bitter::flag_set<control, tcp_flag, 2>;
+
+enum feature
+{
+    compressed, encrypted, signed_
+};
+
+using header = bitter::lsb0_layout<uint32_t, 8, 1, 1, 1, 21>;
+using features = bitter::flag_set<header, feature, 1, 3>;
+}
+
+TEST(test_flag_set, masks)
+{
+    static_assert(tcp_flags::mask(tcp_flag::fin) == 0x1, "");
+    static_assert(tcp_flags::mask(tcp_flag::ns) == 0x100, "");
+    static_assert(tcp_flags::mask({tcp_flag::syn, tcp_flag::ack}) == 0x12,
+                  "");
+    static_assert(tcp_flags::all() == 0x1FF, "");
+
+    EXPECT_EQ(9U, tcp_flags::flags);
+    EXPECT_EQ(3U, features::flags);
+    EXPECT_EQ(0x100U, features::mask(compressed));
+    EXPECT_EQ(0x400U, features::mask(signed_));
+    EXPECT_EQ(0x700U, features::all());
+}
+
+TEST(test_flag_set, test_set_clear)
+{
+    // Data offset 5 and SYN
+    uint16_t value = 0x5002;
+
+    EXPECT_TRUE(tcp_flags::test(value, tcp_flag::syn));
+    EXPECT_FALSE(tcp_flags::test(value, tcp_flag::ack));
+
+    const uint16_t syn_ack = tcp_flags::mask({tcp_flag::syn, tcp_flag::ack});
+
+    EXPECT_TRUE(tcp_flags::test_any(value, syn_ack));
+    EXPECT_FALSE(tcp_flags::test_all(value, syn_ack));
+
+    value = tcp_flags::set(value, syn_ack);
+    EXPECT_EQ(0x5012U, value);
+    EXPECT_TRUE(tcp_flags::test_all(value, syn_ack));
+    EXPECT_EQ(5U, control::get<0>(value));
+
+    value = tcp_flags::clear(value, tcp_flags::mask(
+        {tcp_flag::syn, tcp_flag::rst}));
+    EXPECT_EQ(0x5010U, value);
+    EXPECT_TRUE(tcp_flags::test(value, tcp_flag::ack));
+
+    value = tcp_flags::clear(value, tcp_flags::all());
+    EXPECT_EQ(0x5000U, value);
+    EXPECT_FALSE(tcp_flags::test_any(value, tcp_flags::all()));
+
+    // The flags agree with the field accessors
+    uint32_t bits = header::set<3>(0xFF, 1);
+    EXPECT_TRUE(features::test(bits, signed_));
+    EXPECT_FALSE(features::test(bits, encrypted));
+    EXPECT_EQ(header::set<2>(bits, 1), features::set(bits,
+        features::mask(encrypted)));
+}
+
+TEST(test_flag_set, count)
+{
+    std::vector<uint16_t> values(1000);
+
+    for (auto& value : values)
+    {
+        value = static_cast<uint16_t>(rand());
+    }
+
+    std::vector<uint64_t> counts(tcp_flags::flags, 0);
+    tcp_flags::count(values.data(), values.size(), counts.data());
+
+    for (uint32_t flag = 0; flag < tcp_flags::flags; ++flag)
+    {
+        uint64_t expected = 0;
+
+        for (auto value : values)
+        {
+            expected += control::table::get(value, flag + 2);
+        }
+
+        EXPECT_EQ(expected, counts[flag]);
+    }
+
+    // The counts accumulate
+    tcp_flags::count(values.data(), 10, counts.data());
+    tcp_flags::count(nullptr, 0, counts.data());
+
+    uint64_t fin = 0;
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+        fin += (values[i] & 0x1) * (i < 10 ? 2 : 1);
+    }
+
+    EXPECT_EQ(fin, counts[uint32_t(tcp_flag::fin)]);
+}
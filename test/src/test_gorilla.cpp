@@ -0,0 +1,151 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/gorilla.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+template<class BitNumbering>
+uint64_t check(const std::vector<uint64_t>& values)
+{
+    std::vector<uint8_t> data(values.size() * 10 + 8);
+
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+    bitter::gorilla_encoder<BitNumbering> encoder(writer);
+    encoder.encode(values.data(), values.size());
+    writer.flush();
+
+    bitter::bit_stream_reader<BitNumbering> reader(data.data(), writer.size());
+    bitter::gorilla_decoder<BitNumbering> decoder(reader);
+
+    std::vector<uint64_t> decoded(values.size());
+    decoder.decode(decoded.data(), decoded.size());
+    EXPECT_EQ(values, decoded);
+
+    return writer.size();
+}
+}
+
+TEST(test_gorilla, small)
+{
+    std::vector<uint8_t> data(32);
+
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+    bitter::gorilla_encoder<bitter::msb0> encoder(writer);
+
+    // 1 1 <leading 60> <bits 3 - 1> 101
+    encoder.encode(0xA);
+    // 0
+    encoder.encode(0xA);
+    // 1 0 001 as the XOR 0010 is in the window of the previous XOR
+    encoder.encode(0x8);
+    writer.flush();
+
+    // 11 111100 000010 101 0 10 001 -> 23 bits
+    EXPECT_EQ(3U, writer.size());
+    EXPECT_EQ(0xFCU, data[0]);
+    EXPECT_EQ(0x0AU, data[1]);
+    EXPECT_EQ(0xA2U, data[2]);
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), writer.size());
+    bitter::gorilla_decoder<bitter::msb0> decoder(reader);
+
+    EXPECT_EQ(0xAU, decoder.decode());
+    EXPECT_EQ(0xAU, decoder.decode());
+    EXPECT_EQ(0x8U, decoder.decode());
+}
+
+TEST(test_gorilla, edge_cases)
+{
+    std::vector<uint64_t> values =
+    {
+        0, 0, ~uint64_t{0}, 0, 1, 0x8000000000000000U, 0x8000000000000001U,
+        ~uint64_t{0}, 0x5555555555555555U, 0xAAAAAAAAAAAAAAAAU, 0
+    };
+
+    check<bitter::msb0>(values);
+    check<bitter::lsb0>(values);
+    check<bitter::msb0>({});
+}
+
+TEST(test_gorilla, random)
+{
+    std::vector<uint64_t> values(10000);
+
+    for (auto& value : values)
+    {
+        value = (uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^ rand();
+    }
+
+    check<bitter::msb0>(values);
+    check<bitter::lsb0>(values);
+}
+
+TEST(test_gorilla, compression)
+{
+    // Samples of a packed state word where a few low bits change
+    std::vector<uint64_t> values(10000);
+    uint64_t state = 0x0123456789AB0000U;
+
+    for (auto& value : values)
+    {
+        if (rand() % 4 == 0)
+        {
+            state ^= uint64_t(rand() % 256) << 8;
+        }
+
+        value = state;
+    }
+
+    uint64_t bytes = check<bitter::msb0>(values);
+
+    // About 1 bit for the unchanged and 10 bits for the changed samples
+    EXPECT_LT(bytes * 8, values.size() * 8);
+}
+
+TEST(test_gorilla, invalid)
+{
+    std::vector<uint64_t> decoded(4);
+
+    // A window of 63 leading zeros and 64 bits
+    std::vector<uint8_t> wide(16, 0xFF);
+    bitter::bit_stream_reader<bitter::msb0> wide_reader(wide.data(),
+                                                        wide.size());
+    bitter::gorilla_decoder<bitter::msb0> wide_decoder(wide_reader);
+
+    EXPECT_EQ(0U, wide_decoder.decode());
+    EXPECT_FALSE(wide_reader.is_valid());
+
+    // Reusing the window before the first one
+    std::vector<uint8_t> reuse(16, 0x80);
+    bitter::bit_stream_reader<bitter::msb0> reuse_reader(reuse.data(),
+                                                         reuse.size());
+    bitter::gorilla_decoder<bitter::msb0> reuse_decoder(reuse_reader);
+
+    EXPECT_EQ(0U, reuse_decoder.decode(decoded.data(), decoded.size()));
+    EXPECT_FALSE(reuse_reader.is_valid());
+
+    // A stream cut within the third word
+    std::vector<uint64_t> values = { 0x1234, 0x1234, 0xFFFF000000000000U };
+    std::vector<uint8_t> data(64);
+
+    bitter::bit_stream_writer<bitter::lsb0> writer(data.data(), data.size());
+    bitter::gorilla_encoder<bitter::lsb0> encoder(writer);
+    encoder.encode(values.data(), values.size());
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::lsb0> reader(data.data(), 4);
+    bitter::gorilla_decoder<bitter::lsb0> decoder(reader);
+
+    EXPECT_EQ(2U, decoder.decode(decoded.data(), values.size()));
+    EXPECT_EQ(0x1234U, decoded[1]);
+    EXPECT_FALSE(reader.is_valid());
+}
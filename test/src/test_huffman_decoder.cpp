@@ -0,0 +1,192 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/huffman_decoder.hpp>
+#include <bitter/huffman_encoder.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// The fixed literal/length code of DEFLATE (RFC 1951 section 3.2.6)
+std::vector<uint8_t> fixed_lengths()
+{
+    std::vector<uint8_t> lengths(288);
+
+    for (uint32_t i = 0; i < 288; ++i)
+    {
+        lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+    }
+
+    return lengths;
+}
+
+// A skewed code with lengths 1, 2, ..., 20, 20
+std::vector<uint8_t> skewed_lengths()
+{
+    std::vector<uint8_t> lengths;
+
+    for (uint8_t i = 1; i <= 20; ++i)
+    {
+        lengths.push_back(i);
+    }
+
+    lengths.push_back(20);
+    return lengths;
+}
+
+template<class BitNumbering>
+void test_round_trip(const std::vector<uint8_t>& lengths, uint32_t root_bits)
+{
+    const uint32_t count = 2000;
+
+    std::vector<uint32_t> symbols(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        do
+        {
+            symbols[i] = rand() % lengths.size();
+        }
+        while (lengths[symbols[i]] == 0);
+    }
+
+    bitter::huffman_encoder<BitNumbering> encoder(
+        lengths.data(), lengths.size());
+
+    std::vector<uint8_t> data(count * 4);
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+    encoder.encode(writer, symbols.data(), count);
+    writer.flush();
+
+    bitter::huffman_decoder<BitNumbering> decoder(
+        lengths.data(), lengths.size(), root_bits);
+
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            ASSERT_EQ(symbols[i], decoder.decode(reader));
+        }
+    }
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        std::vector<uint32_t> decoded(count);
+        EXPECT_EQ(count, decoder.decode(reader, decoded.data(), count));
+        EXPECT_EQ(symbols, decoded);
+        EXPECT_LT(reader.bits_left(), 8U);
+    }
+}
+}
+
+TEST(test_huffman_decoder, decode_msb0)
+{
+    // The example from RFC 1951 section 3.2.2: B = 00, A = 010, H = 1111
+    std::vector<uint8_t> lengths = { 3, 3, 3, 3, 3, 2, 4, 4 };
+    std::vector<uint8_t> data = { 0b00010111, 0b10000000 };
+
+    bitter::huffman_decoder<bitter::msb0> decoder(
+        lengths.data(), lengths.size());
+    EXPECT_EQ(4U, decoder.max_length());
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+    EXPECT_EQ(5U, decoder.decode(reader));
+    EXPECT_EQ(0U, decoder.decode(reader));
+    EXPECT_EQ(7U, decoder.decode(reader));
+}
+
+TEST(test_huffman_decoder, decode_lsb0)
+{
+    // Same codes as above, but each byte is filled from the least
+    // significant bit as in DEFLATE
+    std::vector<uint8_t> lengths = { 3, 3, 3, 3, 3, 2, 4, 4 };
+    std::vector<uint8_t> data = { 0b11101000, 0b00000001 };
+
+    bitter::huffman_decoder<bitter::lsb0> decoder(
+        lengths.data(), lengths.size());
+
+    bitter::bit_stream_reader<bitter::lsb0> reader(data.data(), data.size());
+    EXPECT_EQ(5U, decoder.decode(reader));
+    EXPECT_EQ(0U, decoder.decode(reader));
+    EXPECT_EQ(7U, decoder.decode(reader));
+}
+
+TEST(test_huffman_decoder, incomplete_code)
+{
+    // Only the code 0 is assigned, 1 is invalid
+    std::vector<uint8_t> lengths = { 0, 1 };
+    std::vector<uint8_t> data = { 0b00100000 };
+
+    bitter::huffman_decoder<bitter::msb0> decoder(
+        lengths.data(), lengths.size());
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), data.size());
+
+    std::vector<uint32_t> symbols(8);
+    EXPECT_EQ(2U, decoder.decode(reader, symbols.data(), symbols.size()));
+    EXPECT_EQ(1U, symbols[0]);
+    EXPECT_EQ(1U, symbols[1]);
+    EXPECT_EQ(bitter::huffman_decoder<bitter::msb0>::invalid_symbol,
+              decoder.decode(reader));
+}
+
+TEST(test_huffman_decoder, invalid_lengths)
+{
+    using decoder_type = bitter::huffman_decoder<bitter::msb0>;
+
+    // Over-subscribed: three codes of one bit, five of two bits, and a
+    // length above the largest supported one
+    std::vector<std::vector<uint8_t>> invalid =
+    {
+        { 1, 1, 1 }, { 2, 2, 2, 2, 2 }, { 1, 2, 2, 3 }, { 1, 33 }
+    };
+
+    std::vector<uint8_t> data(16, 0x55);
+
+    for (const auto& lengths : invalid)
+    {
+        decoder_type decoder(lengths.data(), lengths.size());
+        EXPECT_FALSE(decoder.is_valid());
+        EXPECT_EQ(0U, decoder.max_length());
+
+        bitter::bit_stream_reader<bitter::msb0> reader(data.data(),
+                                                       data.size());
+
+        std::vector<uint32_t> symbols(8);
+        EXPECT_EQ(decoder_type::invalid_symbol, decoder.decode(reader));
+        EXPECT_EQ(0U, decoder.decode(reader, symbols.data(), symbols.size()));
+
+        bitter::huffman_encoder<bitter::msb0> encoder(lengths.data(),
+                                                      lengths.size());
+        EXPECT_FALSE(encoder.is_valid());
+    }
+
+    // A complete code and an incomplete one are valid
+    std::vector<uint8_t> complete = { 1, 2, 2 };
+    std::vector<uint8_t> incomplete = { 1, 0, 3 };
+
+    EXPECT_TRUE(decoder_type(complete.data(), complete.size()).is_valid());
+    EXPECT_TRUE(decoder_type(incomplete.data(), incomplete.size()).is_valid());
+}
+
+TEST(test_huffman_decoder, round_trip)
+{
+    test_round_trip<bitter::msb0>(fixed_lengths(), 10);
+    test_round_trip<bitter::lsb0>(fixed_lengths(), 10);
+
+    // Root tables smaller than the longest code use sub tables
+    test_round_trip<bitter::msb0>(fixed_lengths(), 7);
+    test_round_trip<bitter::lsb0>(fixed_lengths(), 7);
+    test_round_trip<bitter::msb0>(skewed_lengths(), 9);
+    test_round_trip<bitter::lsb0>(skewed_lengths(), 9);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/key.hpp>
+#include <bitter/detail/popcount.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_key, get)
+{
+    // version, protocol, source port, destination port
+    using header = bitter::msb0_layout<uint64_t, 4, 12, 16, 16, 16>;
+    using flow = bitter::key<header, 1, 2, 3>;
+    using reversed = bitter::key<header, 3, 2, 1>;
+
+    static_assert(flow::bits == 44, "");
+    static_assert(std::is_same<flow::key_type, uint64_t>::value, "");
+
+    uint64_t value = 0x5006BEEF1234ABCDU;
+
+    EXPECT_EQ(0x006BEEF1234U, flow::get(value));
+    EXPECT_EQ(0x1234BEEF006U, reversed::get(value));
+}
+
+TEST(test_key, key_type)
+{
+    using header = bitter::lsb0_layout<uint32_t, 8, 8, 16>;
+
+    static_assert(std::is_same<bitter::key<header, 0>::key_type,
+                  uint8_t>::value, "");
+    static_assert(std::is_same<bitter::key<header, 0, 1>::key_type,
+                  uint16_t>::value, "");
+    static_assert(std::is_same<bitter::key<header, 2, 0>::key_type,
+                  uint32_t>::value, "");
+
+    EXPECT_EQ(0xCDU, (bitter::key<header, 0>::get(0x1234ABCDU)));
+    EXPECT_EQ(0xABCDU, (bitter::key<header, 1, 0>::get(0x1234ABCDU)));
+    EXPECT_EQ(0xCDABU, (bitter::key<header, 0, 1>::get(0x1234ABCDU)));
+}
+
+TEST(test_key, bulk)
+{
+    using header = bitter::lsb0_layout<uint64_t, 3, 13, 16, 32>;
+    using flow = bitter::key<header, 3, 1>;
+
+    std::vector<uint64_t> values(64);
+
+    for (auto& value : values)
+    {
+        value = (uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^ rand();
+    }
+
+    std::vector<flow::key_type> keys(values.size());
+    std::vector<uint64_t> hashes(values.size());
+    flow::get(values.data(), values.size(), keys.data(), hashes.data());
+
+    std::set<uint64_t> distinct;
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+        uint64_t expected = (header::get<3>(values[i]) << 13) |
+                            header::get<1>(values[i]);
+
+        EXPECT_EQ(expected, keys[i]);
+        EXPECT_EQ(flow::hash(keys[i]), hashes[i]);
+        distinct.insert(hashes[i]);
+    }
+
+    EXPECT_EQ(values.size(), distinct.size());
+}
+
+TEST(test_key, hash)
+{
+    using flow = bitter::key<bitter::lsb0_layout<uint32_t, 32>, 0>;
+
+    // Keys differing in a single bit give very different hashes
+    uint64_t a = flow::hash(0);
+    uint64_t b = flow::hash(1);
+
+    EXPECT_NE(a, b);
+    EXPECT_GT(bitter::popcount(flow::hash(0x100) ^ flow::hash(0x101)), 10U);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_key, five_tuple)
+{
+    // Source and destination address, ports and protocol
+    using header = bitter::msb0_layout<bitter::u104, 32, 32, 16, 16, 8>;
+    using flow = bitter::key<header, 0, 1, 2, 3, 4>;
+    using ports = bitter::key<header, 4, 3, 2>;
+
+    static_assert(flow::bits == 104, "");
+    static_assert(std::is_same<flow::key_type, bitter::uint128_t>::value, "");
+    static_assert(std::is_same<ports::key_type, uint64_t>::value, "");
+
+    bitter::uint128_t value = header::set<0>(0, 0xC0A80001U);
+    value = header::set<1>(value, 0x08080808U);
+    value = header::set<2>(value, 0xD431U);
+    value = header::set<3>(value, 0x0035U);
+    value = header::set<4>(value, 0x11U);
+
+    EXPECT_TRUE(value == flow::get(value));
+    EXPECT_EQ(0x110035D431U, ports::get(value));
+
+    // The high and low words of the key both change the hash
+    bitter::uint128_t other = header::set<0>(value, 0xC0A80002U);
+    EXPECT_NE(flow::hash(flow::get(value)), flow::hash(flow::get(other)));
+
+    other = header::set<4>(value, 0x06U);
+    EXPECT_NE(flow::hash(flow::get(value)), flow::hash(flow::get(other)));
+
+    std::vector<flow::key_type> keys(2);
+    std::vector<uint64_t> hashes(2);
+    std::vector<bitter::uint128_t> values = { value, other };
+
+    flow::get(values.data(), values.size(), keys.data(), hashes.data());
+    EXPECT_TRUE(keys[1] == other);
+    EXPECT_EQ(flow::hash(other), hashes[1]);
+}
+#endif
@@ -0,0 +1,50 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+TEST(test_layout, lsb0)
+{
+    using layout = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+
+    static_assert(layout::fields == 3, "");
+    static_assert(layout::bits == 32, "");
+    static_assert(layout::field_size<1>() == 12, "");
+    static_assert(layout::field_offset<1>() == 4, "");
+    static_assert(layout::field_mask<1>() == 0xFFF, "");
+    static_assert(std::is_same<layout::value_type, uint32_t>::value, "");
+
+    uint32_t value = layout::set<1>(0, 0xABC);
+    value = layout::set<2>(value, 0x1234);
+
+    EXPECT_EQ(0x1234ABC0U, value);
+    EXPECT_EQ(0xABCU, layout::get<1>(value));
+    EXPECT_EQ(0x1234U, layout::get<2>(value));
+    EXPECT_EQ(0x1234U, layout::reader_type(value).field<2>().as<uint32_t>());
+    EXPECT_EQ(0xABCU, layout::table::get(value, 1));
+}
+
+TEST(test_layout, msb0)
+{
+    using layout = bitter::msb0_layout<bitter::u24, 4, 12, 8>;
+
+    static_assert(layout::bits == 24, "");
+    static_assert(layout::field_offset<0>() == 20, "");
+
+    layout::writer_type writer;
+    writer.field<0>(0xA);
+    writer.field<1>(0xBCD);
+    writer.field<2>(0xEF);
+
+    EXPECT_EQ(0xABCDEFU, writer.data());
+    EXPECT_EQ(0xAU, layout::get<0>(writer.data()));
+    EXPECT_EQ(0xEFU, layout::get<2>(writer.data()));
+}
@@ -0,0 +1,135 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/leb128.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_leb128, encode)
+{
+    std::vector<uint8_t> data(bitter::leb128_max_size);
+
+    EXPECT_EQ(1U, bitter::leb128_encode(0U, data.data()));
+    EXPECT_EQ(0x00U, data[0]);
+
+    EXPECT_EQ(2U, bitter::leb128_encode(300U, data.data()));
+    EXPECT_EQ(0xACU, data[0]);
+    EXPECT_EQ(0x02U, data[1]);
+
+    EXPECT_EQ(3U, bitter::leb128_encode(624485U, data.data()));
+    EXPECT_EQ(0xE5U, data[0]);
+    EXPECT_EQ(0x8EU, data[1]);
+    EXPECT_EQ(0x26U, data[2]);
+
+    EXPECT_EQ(10U, bitter::leb128_encode(~uint64_t{0}, data.data()));
+    EXPECT_EQ(0x01U, data[9]);
+
+    EXPECT_EQ(1U, bitter::leb128_size(127U));
+    EXPECT_EQ(2U, bitter::leb128_size(128U));
+    EXPECT_EQ(10U, bitter::leb128_size(~uint64_t{0}));
+}
+
+TEST(test_leb128, decode)
+{
+    // Short buffer (byte at a time) and padded buffer (fast path)
+    std::vector<uint8_t> data = { 0xE5, 0x8E, 0x26 };
+    std::vector<uint8_t> padded = { 0xE5, 0x8E, 0x26, 0, 0, 0, 0, 0 };
+
+    uint64_t value = 0;
+    EXPECT_EQ(3U, bitter::leb128_decode(data.data(), data.size(), value));
+    EXPECT_EQ(624485U, value);
+
+    value = 0;
+    EXPECT_EQ(3U, bitter::leb128_decode(padded.data(), padded.size(), value));
+    EXPECT_EQ(624485U, value);
+
+    // Truncated
+    EXPECT_EQ(0U, bitter::leb128_decode(data.data(), 2, value));
+
+    // The largest value, and the tenth byte with bits above bit 63 or a
+    // continuation bit
+    std::vector<uint8_t> wide(10, 0xFF);
+    wide[9] = 0x01;
+
+    EXPECT_EQ(10U, bitter::leb128_decode(wide.data(), wide.size(), value));
+    EXPECT_EQ(~uint64_t{0}, value);
+
+    wide[9] = 0x02;
+    EXPECT_EQ(0U, bitter::leb128_decode(wide.data(), wide.size(), value));
+
+    wide[9] = 0x81;
+    wide.push_back(0x00);
+    EXPECT_EQ(0U, bitter::leb128_decode(wide.data(), wide.size(), value));
+}
+
+TEST(test_leb128, round_trip)
+{
+    const uint32_t count = 1000;
+
+    std::vector<uint64_t> values(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // Mix of small values and values of every length
+        uint64_t value = (uint64_t(rand()) << 42) ^ (uint64_t(rand()) << 21) ^
+                         uint64_t(rand());
+        uint32_t bits = rand() % 65;
+        values[i] = i % 3 == 0 ? rand() % 128 :
+                    bits == 64 ? value : value & ((uint64_t{1} << bits) - 1);
+    }
+
+    std::vector<uint8_t> data(count * bitter::leb128_max_size);
+    uint64_t size = bitter::leb128_encode(values.data(), count, data.data());
+
+    // Single value decode
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint64_t value = 0;
+        uint32_t read = bitter::leb128_decode(
+            data.data() + offset, size - offset, value);
+
+        ASSERT_EQ(bitter::leb128_size(values[i]), read);
+        EXPECT_EQ(values[i], value);
+        offset += read;
+    }
+    EXPECT_EQ(size, offset);
+
+    // Bulk decode
+    std::vector<uint64_t> decoded(count);
+    EXPECT_EQ(size, bitter::leb128_decode(
+        data.data(), size, decoded.data(), count));
+    EXPECT_EQ(values, decoded);
+}
+
+TEST(test_leb128, decode_bulk_small)
+{
+    std::vector<uint64_t> values(100);
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = i;
+    }
+
+    values[50] = 1000;
+
+    std::vector<uint8_t> data(values.size() * bitter::leb128_max_size);
+    uint64_t size = bitter::leb128_encode(
+        values.data(), values.size(), data.data());
+    EXPECT_EQ(values.size() + 1, size);
+
+    std::vector<uint64_t> decoded(values.size());
+    EXPECT_EQ(size, bitter::leb128_decode(
+        data.data(), size, decoded.data(), decoded.size()));
+    EXPECT_EQ(values, decoded);
+
+    // Not enough data for all values
+    EXPECT_EQ(0U, bitter::leb128_decode(
+        data.data(), size - 1, decoded.data(), decoded.size()));
+}
@@ -0,0 +1,267 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/lpm_table.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct route
+{
+    std::vector<uint8_t> prefix;
+    uint32_t length;
+    uint32_t value;
+};
+
+bool matches(const route& r, const uint8_t* key)
+{
+    for (uint32_t bit = 0; bit < r.length; ++bit)
+    {
+        uint32_t shift = 7 - bit % 8;
+
+        if (((r.prefix[bit / 8] >> shift) & 1U) != ((key[bit / 8] >> shift) & 1U))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The value of the longest (and for equal prefixes last) matching route
+template<class Table>
+uint32_t reference(const std::vector<route>& routes, const uint8_t* key)
+{
+    uint32_t value = Table::no_match;
+    uint32_t length = 0;
+
+    for (const auto& r : routes)
+    {
+        if (matches(r, key) && (value == Table::no_match || r.length >= length))
+        {
+            value = r.value;
+            length = r.length;
+        }
+    }
+
+    return value;
+}
+
+std::vector<uint8_t> random_key(uint32_t bytes)
+{
+    std::vector<uint8_t> key(bytes);
+
+    for (auto& byte : key)
+    {
+        byte = rand() % 256;
+    }
+
+    return key;
+}
+
+template<class Table>
+void check_random(uint32_t route_count, uint32_t key_count)
+{
+    const uint32_t bytes = Table::key_bytes;
+
+    Table table;
+    std::vector<route> routes;
+
+    for (uint32_t i = 0; i < route_count; ++i)
+    {
+        // Share the first bytes of the prefixes to get nested prefixes
+        route r;
+        r.prefix = random_key(bytes);
+        r.prefix[0] = rand() % 4;
+        r.length = rand() % (bytes * 8 + 1);
+        r.value = rand() % (Table::max_value + 1);
+
+        table.insert(r.prefix.data(), r.length, r.value);
+        routes.push_back(r);
+    }
+
+    std::vector<uint8_t> keys;
+
+    for (uint32_t i = 0; i < key_count; ++i)
+    {
+        // Use keys close to the prefixes
+        auto key = i % 2 ? random_key(bytes) : routes[i % routes.size()].prefix;
+        key[bytes - 1] ^= rand() % 4;
+        key[0] = rand() % 4;
+        keys.insert(keys.end(), key.begin(), key.end());
+    }
+
+    std::vector<uint32_t> values(key_count);
+    table.lookup(keys.data(), key_count, values.data());
+
+    for (uint32_t i = 0; i < key_count; ++i)
+    {
+        const uint8_t* key = keys.data() + i * bytes;
+        uint32_t expected = reference<Table>(routes, key);
+
+        ASSERT_EQ(expected, table.lookup(key));
+        ASSERT_EQ(expected, values[i]);
+    }
+}
+}
+
+TEST(test_lpm_table, ipv4)
+{
+    bitter::ipv4_lpm_table table;
+
+    table.insert(0x0A000000U, 8, 1);
+    table.insert(0x0A010200U, 24, 2);
+    table.insert(0x0A010280U, 25, 3);
+    table.insert(0x0A010203U, 32, 4);
+
+    EXPECT_EQ(1U, table.lookup(0x0A020203U));
+    EXPECT_EQ(2U, table.lookup(0x0A010201U));
+    EXPECT_EQ(3U, table.lookup(0x0A0102F0U));
+    EXPECT_EQ(4U, table.lookup(0x0A010203U));
+    EXPECT_EQ(bitter::ipv4_lpm_table::no_match, table.lookup(0x0B000000U));
+
+    // A shorter prefix inserted later does not hide the longer ones
+    table.insert(0x0A010000U, 16, 5);
+    table.insert(0x00000000U, 0, 6);
+
+    EXPECT_EQ(5U, table.lookup(0x0A0101F0U));
+    EXPECT_EQ(2U, table.lookup(0x0A010201U));
+    EXPECT_EQ(4U, table.lookup(0x0A010203U));
+    EXPECT_EQ(6U, table.lookup(0x0B000000U));
+
+    // Replacing a route
+    table.insert(0x0A010280U, 25, 7);
+    EXPECT_EQ(7U, table.lookup(0x0A0102F0U));
+}
+
+TEST(test_lpm_table, ipv4_random)
+{
+    check_random<bitter::ipv4_lpm_table>(300, 2000);
+}
+
+TEST(test_lpm_table, ipv6_random)
+{
+    check_random<bitter::ipv6_lpm_table>(300, 2000);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_lpm_table, ipv6)
+{
+    bitter::ipv6_lpm_table table;
+
+    bitter::uint128_t prefix = bitter::uint128_t(0x20010DB8U) << 96;
+    table.insert(prefix, 32, 1);
+    table.insert(prefix | (bitter::uint128_t(0xAC10U) << 80), 48, 2);
+
+    EXPECT_EQ(1U, table.lookup(prefix | 0x1U));
+    EXPECT_EQ(2U, table.lookup(prefix | (bitter::uint128_t(0xAC10U) << 80) | 0x1U));
+    EXPECT_EQ(bitter::ipv6_lpm_table::no_match, table.lookup(bitter::uint128_t(1)));
+
+    // Batched lookups of 128 bit keys
+    std::vector<bitter::uint128_t> keys;
+    std::vector<uint8_t> bytes;
+
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        std::vector<uint8_t> key = random_key(16);
+        key[0] = 0x20;
+        key[1] = 0x01;
+
+        if (i % 2 == 0)
+        {
+            key[2] = 0x0D;
+            key[3] = 0xB8;
+        }
+
+        bitter::uint128_t value = 0;
+
+        for (uint8_t byte : key)
+        {
+            value = (value << 8) | byte;
+        }
+
+        keys.push_back(value);
+        bytes.insert(bytes.end(), key.begin(), key.end());
+    }
+
+    std::vector<uint32_t> values(keys.size());
+    table.lookup(keys.data(), keys.size(), values.data());
+
+    for (uint32_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(table.lookup(bytes.data() + i * 16), values[i]);
+        EXPECT_EQ(table.lookup(keys[i]), values[i]);
+    }
+}
+#endif
+
+TEST(test_lpm_table, ipv4_batched)
+{
+    bitter::ipv4_lpm_table table;
+    EXPECT_TRUE(table.insert(0x0A000000U, 8, 1));
+    EXPECT_TRUE(table.insert(0x0A010200U, 24, 2));
+    EXPECT_TRUE(table.insert(0x0A010203U, 32, 3));
+
+    std::vector<uint32_t> keys = { 0x0A020203U, 0x0A010201U, 0x0A010203U,
+                                   0x0B000000U };
+    std::vector<uint32_t> values(keys.size());
+    table.lookup(keys.data(), keys.size(), values.data());
+
+    EXPECT_EQ(std::vector<uint32_t>({ 1, 2, 3,
+                                      bitter::ipv4_lpm_table::no_match }),
+              values);
+}
+
+TEST(test_lpm_table, out_of_child_tables)
+{
+    // One bit strides make every bit of a key a child table, so random
+    // 128 bit prefixes use up the 2^22 child tables quickly
+    using table_type = bitter::lpm_table<128, 1, 1>;
+    table_type table;
+
+    EXPECT_FALSE(table.insert(random_key(16).data(), 8,
+                              table_type::max_value + 1));
+
+    std::vector<route> routes;
+    bool full = false;
+
+    while (!full)
+    {
+        route r{ random_key(16), 128, static_cast<uint32_t>(routes.size()) };
+        full = !table.insert(r.prefix.data(), r.length, r.value);
+
+        if (!full)
+        {
+            routes.push_back(r);
+        }
+        else
+        {
+            // The failed insert changed no lookup
+            EXPECT_EQ(table_type::no_match, table.lookup(r.prefix.data()));
+        }
+    }
+
+    EXPECT_EQ(table_type::max_value + 1U, table.children());
+
+    for (uint32_t i = 0; i < routes.size(); i += 97)
+    {
+        ASSERT_EQ(routes[i].value, table.lookup(routes[i].prefix.data()));
+    }
+
+    // Prefixes within the existing child tables can still be added
+    EXPECT_TRUE(table.insert(routes[0].prefix.data(), 100, 7));
+    EXPECT_EQ(routes[0].value, table.lookup(routes[0].prefix.data()));
+}
+
+TEST(test_lpm_table, small_strides)
+{
+    check_random<bitter::lpm_table<16, 4, 4>>(100, 2000);
+    check_random<bitter::lpm_table<24, 3, 7>>(100, 2000);
+}
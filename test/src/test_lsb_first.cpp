@@ -0,0 +1,76 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/lsb_first.hpp>
+#include <bitter/reader.hpp>
+#include <bitter/writer.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_lsb_first, field_offset)
+{
+    EXPECT_EQ(0U, (bitter::lsb_first::field_offset<0, 4, 8, 4>()));
+    EXPECT_EQ(4U, (bitter::lsb_first::field_offset<1, 4, 8, 4>()));
+    EXPECT_EQ(12U, (bitter::lsb_first::field_offset<2, 4, 8, 4>()));
+}
+
+TEST(test_lsb_first, read)
+{
+    // The bytes 0xAB, 0xCD sent with the low nibble of each byte first
+    auto reader = bitter::reader<uint16_t, bitter::lsb_first, 4, 8, 4>(0xABCD);
+
+    EXPECT_EQ(0xBU, reader.field<0>().as<uint8_t>());
+    EXPECT_EQ(0xDAU, reader.field<1>().as<uint8_t>());
+    EXPECT_EQ(0xCU, reader.field<2>().as<uint8_t>());
+
+    EXPECT_EQ(0xDAU, reader.field(1).as<uint64_t>());
+    EXPECT_EQ(0xCU, reader.field(2).as<uint64_t>());
+}
+
+TEST(test_lsb_first, read_single_bits)
+{
+    // The first bit sent is the least significant bit of the first byte
+    auto reader = bitter::reader<bitter::u24, bitter::lsb_first,
+                                 1, 7, 1, 15>(0x010080);
+
+    EXPECT_EQ(1U, reader.field<0>().as<uint32_t>());
+    EXPECT_EQ(0U, reader.field<1>().as<uint32_t>());
+    EXPECT_EQ(0U, reader.field<2>().as<uint32_t>());
+    EXPECT_EQ(0x4000U, reader.field<3>().as<uint32_t>());
+}
+
+TEST(test_lsb_first, write)
+{
+    auto writer = bitter::writer<uint16_t, bitter::lsb_first, 4, 8, 4>();
+    writer.field<0>(0xB);
+    writer.field<1>(0xDA);
+    writer.field<2>(0xC);
+
+    EXPECT_EQ(0xABCDU, writer.data());
+
+    writer.field(1, 0x12);
+    EXPECT_EQ(0x2BC1U, writer.data());
+}
+
+TEST(test_lsb_first, round_trip)
+{
+    using reader_type = bitter::reader<uint32_t, bitter::lsb_first, 3, 10, 13, 6>;
+    using writer_type = bitter::writer<uint32_t, bitter::lsb_first, 3, 10, 13, 6>;
+
+    for (uint32_t value : { 0x00000000U, 0xFFFFFFFFU, 0x12345678U, 0x9ABCDEF0U })
+    {
+        auto reader = reader_type(value);
+        auto writer = writer_type();
+
+        writer.field<0>(reader.field<0>().as<uint32_t>());
+        writer.field<1>(reader.field<1>().as<uint32_t>());
+        writer.field<2>(reader.field<2>().as<uint32_t>());
+        writer.field<3>(reader.field<3>().as<uint32_t>());
+
+        EXPECT_EQ(value, writer.data());
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/merge_columns.hpp>
+#include <bitter/split_columns.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_merge_columns, lsb0)
+{
+    using header = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+
+    std::vector<uint8_t> version = { 0x1, 0xF };
+    std::vector<uint16_t> length = { 0x234, 0xFFF };
+    std::vector<uint32_t> id = { 0x5678, 0x0 };
+    std::vector<uint32_t> headers(2, 0xFFFFFFFFU);
+
+    bitter::merge_columns<header>(headers.data(), headers.size(),
+                                  version.data(), length.data(), id.data());
+
+    EXPECT_EQ(0x56782341U, headers[0]);
+    EXPECT_EQ(0x0000FFFFU, headers[1]);
+}
+
+TEST(test_merge_columns, round_trip)
+{
+    using record = bitter::msb0_layout<bitter::u24, 3, 9, 12>;
+
+    uint64_t count = 5000;
+    std::vector<uint32_t> records(count);
+
+    for (auto& value : records)
+    {
+        value = rand() & 0xFFFFFF;
+    }
+
+    std::vector<uint8_t> a(count);
+    std::vector<uint16_t> b(count);
+    std::vector<uint16_t> c(count);
+
+    bitter::split_columns<record>(records.data(), count, a.data(), b.data(),
+                                  c.data());
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        auto reader = record::reader_type(records[i]);
+        ASSERT_EQ(reader.field<1>().as<uint16_t>(), b[i]);
+    }
+
+    std::vector<uint32_t> merged(count);
+    bitter::merge_columns<record>(merged.data(), count, a.data(), b.data(),
+                                  c.data());
+
+    EXPECT_EQ(records, merged);
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/morton.hpp>
+#include <bitter/reader.hpp>
+#include <bitter/writer.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+TEST(test_morton, field_bits)
+{
+    EXPECT_EQ(0x5555555555555555U, (bitter::morton::field_bits<0, 32, 32>()));
+    EXPECT_EQ(0xAAAAAAAAAAAAAAAAU, (bitter::morton::field_bits<1, 32, 32>()));
+
+    // x2 y2 z1 y1 x1 z0 y0 x0
+    EXPECT_EQ(0x49U, (bitter::morton::field_bits<0, 3, 3, 2>()));
+    EXPECT_EQ(0x92U, (bitter::morton::field_bits<1, 3, 3, 2>()));
+    EXPECT_EQ(0x24U, (bitter::morton::field_bits<2, 3, 3, 2>()));
+
+    EXPECT_EQ(0x8U, (bitter::morton::field_offset<2, 4, 4, 8>()));
+}
+
+TEST(test_morton, read)
+{
+    auto reader = bitter::reader<uint8_t, bitter::morton, 4, 4>(0x9C);
+
+    // x = bits 0, 2, 4, 6 and y = bits 1, 3, 5, 7 of 1001 1100
+    EXPECT_EQ(0x6U, reader.field<0>().as<uint8_t>());
+    EXPECT_EQ(0xAU, reader.field<1>().as<uint8_t>());
+
+    EXPECT_EQ(0x6U, reader.field(0).as<uint8_t>());
+    EXPECT_EQ(0xAU, reader.field(1).as<uint8_t>());
+}
+
+TEST(test_morton, write)
+{
+    auto writer = bitter::writer<uint32_t, bitter::morton, 16, 16>();
+    writer.field<0>(0xFFFF);
+    EXPECT_EQ(0x55555555U, writer.data());
+
+    writer.field<1>(0x0003);
+    EXPECT_EQ(0x5555555FU, writer.data());
+
+    writer.field(0, 0);
+    EXPECT_EQ(0x0000000AU, writer.data());
+}
+
+TEST(test_morton, z_order)
+{
+    // Keys of neighbouring points in a 2x2 block are consecutive
+    using writer_type = bitter::writer<uint16_t, bitter::morton, 8, 8>;
+
+    auto key = [](uint32_t x, uint32_t y)
+    {
+        auto writer = writer_type();
+        writer.field<0>(x);
+        writer.field<1>(y);
+        return writer.data();
+    };
+
+    EXPECT_EQ(0U, key(0, 0));
+    EXPECT_EQ(1U, key(1, 0));
+    EXPECT_EQ(2U, key(0, 1));
+    EXPECT_EQ(3U, key(1, 1));
+    EXPECT_EQ(4U, key(2, 0));
+    EXPECT_EQ(0xFFFFU, key(255, 255));
+}
+
+TEST(test_morton, round_trip)
+{
+    using reader_type = bitter::reader<uint64_t, bitter::morton, 21, 21, 22>;
+    using writer_type = bitter::writer<uint64_t, bitter::morton, 21, 21, 22>;
+
+    auto writer = writer_type();
+    writer.field<0>(0x1ABCDE);
+    writer.field<1>(0x012345);
+    writer.field<2>(0x3FFFFF);
+
+    auto reader = reader_type(writer.data());
+    EXPECT_EQ(0x1ABCDEU, reader.field<0>().as<uint64_t>());
+    EXPECT_EQ(0x012345U, reader.field<1>().as<uint64_t>());
+    EXPECT_EQ(0x3FFFFFU, reader.field<2>().as<uint64_t>());
+
+    // Field 2 has the top bit on its own
+    EXPECT_EQ(1U, writer.data() >> 63);
+}
+
+TEST(test_morton, single_field)
+{
+    using reader_type = bitter::reader<uint8_t, bitter::morton, 3, 3, 2>;
+    using order = bitter::detail::field_order<bitter::morton>;
+
+    for (uint32_t value = 0; value < 256; ++value)
+    {
+        // A field read on its own is the field of all fields gathered
+        uint32_t gathered = order::decode<bitter::u8, 3, 3, 2>(value);
+        auto reader = reader_type(value);
+
+        EXPECT_EQ(gathered & 0x7U, reader.field<0>().as<uint32_t>());
+        EXPECT_EQ((gathered >> 3) & 0x7U, reader.field<1>().as<uint32_t>());
+        EXPECT_EQ(gathered >> 6, reader.field<2>().as<uint32_t>());
+
+        // Writing a field leaves the bits of the other fields as they are
+        uint32_t written = bitter::field_set<
+                           bitter::u8, bitter::morton, 1, 3, 3, 2>(value, 0x5);
+
+        EXPECT_EQ(value & ~0x92U, written & ~0x92U);
+        EXPECT_EQ(0x5U, reader_type(written).field<1>().as<uint32_t>());
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/pack_struct.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+enum class kind : uint8_t
+{
+    data, ack, nack
+};
+
+struct header
+{
+    uint8_t version;
+    uint16_t length;
+    bool last;
+    kind type;
+    uint16_t id;
+
+    auto tie() const
+    {
+        return std::tie(version, length, last, type, id);
+    }
+};
+
+using wire = bitter::msb0_layout<uint32_t, 4, 9, 1, 2, 16>;
+
+struct small
+{
+    uint8_t a;
+    uint8_t b;
+};
+
+using pair = bitter::lsb0_layout<uint8_t, 4, 4>;
+}
+
+TEST(test_pack_struct, pack_unpack)
+{
+    header h = { 0x4, 0x1AB, true, kind::nack, 0xBEEF };
+
+    uint32_t packed = bitter::pack_struct<wire>(h);
+
+    uint32_t expected = 0;
+    expected = wire::set<0>(expected, 0x4);
+    expected = wire::set<1>(expected, 0x1AB);
+    expected = wire::set<2>(expected, 1);
+    expected = wire::set<3>(expected, 2);
+    expected = wire::set<4>(expected, 0xBEEF);
+
+    EXPECT_EQ(expected, packed);
+    EXPECT_EQ(0x4D5EBEEFU, packed);
+
+    header u = bitter::unpack_struct<wire, header>(packed);
+    EXPECT_EQ(h.tie(), u.tie());
+
+    small s = bitter::unpack_struct<pair, small>(0xA5);
+    EXPECT_EQ(0x5U, s.a);
+    EXPECT_EQ(0xAU, s.b);
+}
+
+TEST(test_pack_struct, bulk)
+{
+    std::vector<header> headers;
+
+    for (uint16_t i = 0; i < 100; ++i)
+    {
+        headers.push_back(header{ uint8_t(i % 16), uint16_t(i * 5), i % 3 == 0,
+                                  kind(i % 3), uint16_t(i * 601) });
+    }
+
+    std::vector<uint32_t> packed = bitter::pack_structs<wire>(headers);
+    ASSERT_EQ(headers.size(), packed.size());
+
+    for (uint32_t i = 0; i < headers.size(); ++i)
+    {
+        EXPECT_EQ(bitter::pack_struct<wire>(headers[i]), packed[i]);
+    }
+
+    std::vector<header> unpacked =
+        bitter::unpack_structs<wire, header>(packed);
+    ASSERT_EQ(headers.size(), unpacked.size());
+
+    std::vector<header> arrays(headers.size());
+    bitter::unpack_structs<wire>(packed.data(), packed.size(), arrays.data());
+
+    std::vector<uint32_t> repacked(packed.size());
+    bitter::pack_structs<wire>(arrays.data(), arrays.size(),
+                               repacked.data());
+    EXPECT_EQ(packed, repacked);
+
+    for (uint32_t i = 0; i < headers.size(); ++i)
+    {
+        EXPECT_EQ(headers[i].tie(), unpacked[i].tie());
+        EXPECT_EQ(headers[i].tie(), arrays[i].tie());
+    }
+
+    EXPECT_TRUE(bitter::pack_structs<wire>(std::vector<header>()).empty());
+}
@@ -0,0 +1,144 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/radix_sort.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using record = bitter::lsb0_layout<uint64_t, 16, 8, 8, 32>;
+
+std::vector<uint64_t> random_records(uint64_t count)
+{
+    std::vector<uint64_t> records(count);
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        // Few distinct protocols, the last field keeps the original order
+        uint64_t value = record::set<0>(0, rand() % 65536);
+        value = record::set<1>(value, 6 + (rand() % 3) * 5);
+        value = record::set<2>(value, rand() % 256);
+        records[i] = record::set<3>(value, i);
+    }
+
+    return records;
+}
+
+// Sorts by protocol and then port with std::stable_sort
+std::vector<uint64_t> reference(std::vector<uint64_t> records)
+{
+    std::stable_sort(records.begin(), records.end(),
+                     [](uint64_t a, uint64_t b)
+    {
+        auto x = record::reader_type(a);
+        auto y = record::reader_type(b);
+
+        if (x.field<1>().as<uint32_t>() != y.field<1>().as<uint32_t>())
+        {
+            return x.field<1>().as<uint32_t>() < y.field<1>().as<uint32_t>();
+        }
+
+        return x.field<0>().as<uint32_t>() < y.field<0>().as<uint32_t>();
+    });
+
+    return records;
+}
+}
+
+TEST(test_radix_sort, sort)
+{
+    uint64_t sizes[] = { 0, 1, 2, 100, 10000 };
+
+    for (uint64_t size : sizes)
+    {
+        auto records = random_records(size);
+        auto expected = reference(records);
+
+        bitter::radix_sort<record, 1, 0>(records.data(), records.size());
+        EXPECT_EQ(expected, records);
+    }
+}
+
+TEST(test_radix_sort, scratch)
+{
+    using value = bitter::msb0_layout<uint32_t, 3, 29>;
+
+    std::vector<uint32_t> values(5000);
+
+    for (auto& v : values)
+    {
+        v = (uint32_t(rand()) << 16) ^ rand();
+    }
+
+    std::vector<uint32_t> scratch(values.size());
+    bitter::radix_sort<value, 0, 1>(values.data(), values.size(),
+                                    scratch.data());
+
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+
+    // Single 3 bit field, one pass
+    bitter::radix_sort<value, 1>(values.data(), values.size(),
+                                 scratch.data());
+
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end(),
+                               [](uint32_t a, uint32_t b)
+    {
+        return value::get<1>(a) < value::get<1>(b);
+    }));
+}
+
+TEST(test_radix_sort, parallel)
+{
+    for (uint32_t threads = 1; threads <= 4; ++threads)
+    {
+        auto records = random_records(20000);
+        auto expected = reference(records);
+
+        std::vector<uint64_t> scratch(records.size());
+        bitter::parallel_radix_sort<record, 1, 0>(
+            records.data(), records.size(), scratch.data(), threads);
+
+        EXPECT_EQ(expected, records);
+    }
+
+    std::vector<uint64_t> empty;
+    bitter::parallel_radix_sort<record, 1, 0>(empty.data(), 0, empty.data(), 2);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_radix_sort, wide_key)
+{
+    // A 104 bit key of the address, port and sequence fields
+    using wide = bitter::msb0_layout<bitter::u128, 64, 16, 24, 24>;
+
+    std::vector<bitter::uint128_t> records(1000);
+
+    for (uint32_t i = 0; i < records.size(); ++i)
+    {
+        bitter::uint128_t value = wide::set<0>(0, rand() % 4);
+        value = wide::set<1>(value, rand() % 3);
+        value = wide::set<2>(value, rand() % 1000);
+        records[i] = wide::set<3>(value, i);
+    }
+
+    auto expected = records;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](bitter::uint128_t a, bitter::uint128_t b)
+    {
+        return (a >> 24) < (b >> 24);
+    });
+
+    bitter::radix_sort<wide, 0, 1, 2>(records.data(), records.size());
+    EXPECT_TRUE(expected == records);
+}
+#endif
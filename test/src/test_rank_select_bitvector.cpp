@@ -0,0 +1,135 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/rank_select_bitvector.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<uint64_t> random_bits(uint64_t size, uint32_t percent_ones)
+{
+    std::vector<uint64_t> bits((size + 63) / 64, 0);
+
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        if (uint32_t(rand() % 100) < percent_ones)
+        {
+            bits[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+
+    return bits;
+}
+
+void check(const bitter::rank_select_bitvector& vector,
+           const std::vector<uint64_t>& bits, uint64_t size)
+{
+    ASSERT_EQ(size, vector.size());
+
+    uint64_t ones = 0;
+
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        bool bit = (bits[i / 64] >> (i % 64)) & 1U;
+
+        ASSERT_EQ(bit, vector.get(i));
+        ASSERT_EQ(ones, vector.rank1(i));
+        ASSERT_EQ(i - ones, vector.rank0(i));
+
+        if (bit)
+        {
+            ASSERT_EQ(i, vector.select1(ones));
+            ++ones;
+        }
+        else
+        {
+            ASSERT_EQ(i, vector.select0(i - ones));
+        }
+    }
+
+    EXPECT_EQ(ones, vector.count_ones());
+    EXPECT_EQ(ones, vector.rank1(size));
+}
+}
+
+TEST(test_rank_select_bitvector, small)
+{
+    std::vector<uint64_t> bits = { 0x8000000000000001U, 0x5U };
+
+    bitter::rank_select_bitvector vector(bits.data(), 67);
+
+    EXPECT_EQ(4U, vector.count_ones());
+    EXPECT_EQ(1U, vector.rank1(1));
+    EXPECT_EQ(1U, vector.rank1(63));
+    EXPECT_EQ(2U, vector.rank1(64));
+    EXPECT_EQ(63U, vector.select1(1));
+    EXPECT_EQ(66U, vector.select1(3));
+    EXPECT_EQ(1U, vector.select0(0));
+    EXPECT_EQ(65U, vector.select0(62));
+
+    check(vector, bits, 67);
+}
+
+TEST(test_rank_select_bitvector, empty)
+{
+    bitter::rank_select_bitvector vector(nullptr, 0);
+
+    EXPECT_EQ(0U, vector.size());
+    EXPECT_EQ(0U, vector.count_ones());
+    EXPECT_EQ(0U, vector.rank1(0));
+}
+
+TEST(test_rank_select_bitvector, random)
+{
+    uint64_t sizes[] = { 1, 63, 64, 511, 2048, 2049, 100000 };
+    uint32_t densities[] = { 0, 1, 50, 99, 100 };
+
+    for (uint64_t size : sizes)
+    {
+        for (uint32_t density : densities)
+        {
+            auto bits = random_bits(size, density);
+            bitter::rank_select_bitvector vector(bits.data(), size);
+
+            SCOPED_TRACE(size);
+            SCOPED_TRACE(density);
+            check(vector, bits, size);
+        }
+    }
+}
+
+TEST(test_rank_select_bitvector, load_from_memory)
+{
+    uint64_t size = 50000;
+    auto bits = random_bits(size, 10);
+
+    std::vector<uint64_t> stored;
+
+    {
+        bitter::rank_select_bitvector vector(bits.data(), size);
+        stored.assign(vector.data(), vector.data() + vector.data_words());
+    }
+
+    // E.g. the words could now be written to disk and mapped into memory
+    bitter::rank_select_bitvector vector(stored.data());
+    EXPECT_EQ(stored.size(), vector.data_words());
+    check(vector, bits, size);
+}
+
+TEST(test_rank_select_bitvector, overhead)
+{
+    uint64_t size = 1 << 22;
+    auto bits = random_bits(size, 50);
+
+    bitter::rank_select_bitvector vector(bits.data(), size);
+
+    double overhead = (vector.data_words() * 64.0 - size) / size;
+    EXPECT_LT(overhead, 0.05);
+}
@@ -309,3 +309,81 @@ TEST(test_bit_reader, test_const)
         EXPECT_TRUE(value2);
     }
 }
+
+TEST(test_bit_reader, read_runtime_index)
+{
+    uint32_t input = 0x87654321U;
+
+    {
+        auto reader = bitter::lsb0_reader<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>(
+            input);
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            EXPECT_EQ(i + 1, reader.field(i).as<uint8_t>());
+        }
+    }
+
+    {
+        auto reader = bitter::msb0_reader<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>(
+            input);
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            EXPECT_EQ(8 - i, reader.field(i).as<uint8_t>());
+        }
+    }
+
+    {
+        auto reader = bitter::msb0_reader<bitter::u24, 4, 12, 8>(0x123456U);
+
+        EXPECT_EQ(0x1U, reader.field(0).as<uint16_t>());
+        EXPECT_EQ(0x234U, reader.field(1).as<uint16_t>());
+        EXPECT_EQ(0x56U, reader.field(2).as<uint16_t>());
+    }
+}
+
+TEST(test_bit_reader, for_each_field)
+{
+    auto reader = bitter::lsb0_reader<uint32_t, 1, 7, 8, 16>(0x8028041U);
+
+    uint32_t values[4] = { 0 };
+    uint32_t calls = 0;
+
+    reader.for_each_field([&](uint32_t index, auto field)
+    {
+        EXPECT_EQ(calls, index);
+        values[index] = field.template as<uint32_t>();
+        ++calls;
+    });
+
+    EXPECT_EQ(4U, calls);
+    EXPECT_EQ(1U, values[0]);
+    EXPECT_EQ(32U, values[1]);
+    EXPECT_EQ(128U, values[2]);
+    EXPECT_EQ(2050U, values[3]);
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_bit_reader, read_bit_u128)
+{
+    // An IPv6 address: 48 bit routing prefix, 16 bit subnet and 64 bit
+    // interface identifier
+    bitter::uint128_t address =
+        (bitter::uint128_t(0x20010DB8AC100001U) << 64) | 0x0000000000000042U;
+
+    auto reader = bitter::msb0_reader<bitter::u128, 48, 16, 64>(address);
+
+    EXPECT_EQ(0x20010DB8AC10U, reader.field<0>().as<uint64_t>());
+    EXPECT_EQ(0x0001U, reader.field<1>().as<uint16_t>());
+    EXPECT_EQ(0x42U, reader.field<2>().as<uint64_t>());
+    EXPECT_EQ(0x0001U, reader.field(1).as<uint64_t>());
+
+    auto bits = bitter::lsb0_reader<bitter::u72, 4, 64, 4>(
+        (bitter::uint128_t(0xA5) << 64) | 0x0123456789ABCDEFU);
+
+    EXPECT_EQ(0xFU, bits.field<0>().as<uint8_t>());
+    EXPECT_EQ(0x50123456789ABCDEU, bits.field<1>().as<uint64_t>());
+    EXPECT_EQ(0xAU, bits.field<2>().as<uint8_t>());
+}
+#endif
@@ -7,10 +7,16 @@
 #include <bitter/lsb0_reader.hpp>
 #include <bitter/msb0_writer.hpp>
 #include <bitter/msb0_reader.hpp>
+#include <bitter/exp_golomb.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/bit_sliced_column.hpp>
+#include <bitter/lsb_first.hpp>
+#include <bitter/morton.hpp>
 
 #include <gtest/gtest.h>
 
 #include <cassert>
+#include <vector>
 
 TEST(test_readme, writing_a_lsb0_bit_field)
 {
@@ -72,6 +78,22 @@ TEST(test_readme, reading_a_msb0_bit_field)
     assert(value3 == 0x78);
 }
 
+TEST(test_readme, other_bit_numberings)
+{
+    auto reader = bitter::reader<uint16_t, bitter::lsb_first, 4, 8, 4>(
+        0xABCD);
+
+    assert(reader.field<0>().as<uint8_t>() == 0xB);
+    assert(reader.field<1>().as<uint8_t>() == 0xDA);
+    assert(reader.field<2>().as<uint8_t>() == 0xC);
+
+    auto writer = bitter::writer<uint16_t, bitter::morton, 8, 8>();
+    writer.field<0>(3); // x
+    writer.field<1>(1); // y
+
+    assert(writer.data() == 0x7);
+}
+
 TEST(test_readme, reading_a_generic_sized_bit_field)
 {
     auto reader = bitter::msb0_reader<bitter::u24, 4, 12, 8>(0x123456U);
@@ -84,3 +106,55 @@ TEST(test_readme, reading_a_generic_sized_bit_field)
     assert(value1 == 0x234);
     assert(value2 == 0x56);
 }
+
+TEST(test_readme, runtime_field_index)
+{
+    auto reader = bitter::lsb0_reader<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>(
+        0x87654321U);
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        assert(reader.field(i).as<uint8_t>() == i + 1);
+    }
+
+    auto writer = bitter::lsb0_writer<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>();
+
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        writer.field(i, i + 1);
+    }
+
+    assert(writer.data() == 0x87654321U);
+}
+
+TEST(test_readme, bit_streams)
+{
+    std::vector<uint8_t> data(64);
+
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+    writer.write(0x5, 3);
+    bitter::exp_golomb_encode(writer, 1000);
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), writer.size());
+    assert(reader.read(3) == 0x5);
+    assert(bitter::exp_golomb_decode(reader) == 1000);
+}
+
+TEST(test_readme, layouts_and_bit_sliced_columns)
+{
+    using record = bitter::lsb0_layout<uint32_t, 9, 5, 18>;
+
+    uint32_t value = record::set<1>(0, 17);
+    assert(record::get<1>(value) == 17);
+
+    std::vector<uint32_t> records(100, value);
+    records[3] = record::set<1>(0, 2);
+
+    auto column = bitter::slice_field<record, 1>(records.data(),
+                                                 records.size());
+
+    std::vector<uint64_t> result(column.result_words());
+    column.less(10, result.data());
+    assert(result[0] == 0x8 && result[1] == 0);
+}
@@ -0,0 +1,125 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/rice.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_rice, encode)
+{
+    std::vector<uint8_t> data(4, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+
+    // k = 2: 5 -> 01 01, 2 -> 1 10
+    bitter::rice_encode(writer, 5, 2);
+    bitter::rice_encode(writer, 2, 2);
+    EXPECT_EQ(7U, writer.bits_written());
+    writer.flush();
+
+    EXPECT_EQ(0x5CU, data[0]);
+
+    bitter::bit_stream_reader<bitter::msb0> reader(data.data(), 1);
+    EXPECT_EQ(5U, bitter::rice_decode(reader, 2));
+    EXPECT_EQ(2U, bitter::rice_decode(reader, 2));
+}
+
+TEST(test_rice, long_quotient)
+{
+    std::vector<uint8_t> data(64, 0);
+    bitter::bit_stream_writer<bitter::lsb0> writer(data.data(), data.size());
+
+    // A quotient of 300 spans several refills
+    bitter::rice_encode(writer, (300 << 4) | 7, 4);
+    bitter::rice_encode_signed(writer, -3, 1);
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::lsb0> reader(data.data(), data.size());
+    EXPECT_EQ((300U << 4) | 7U, bitter::rice_decode(reader, 4));
+    EXPECT_EQ(-3, bitter::rice_decode_signed(reader, 1));
+}
+
+TEST(test_rice, truncated)
+{
+    // All zero data is a quotient running past the end
+    std::vector<uint8_t> zeros(4, 0);
+    std::vector<uint64_t> values(4);
+
+    bitter::bit_stream_reader<bitter::msb0> reader(zeros.data(), zeros.size());
+    EXPECT_EQ(0U, bitter::rice_decode(reader, 3));
+    EXPECT_FALSE(reader.is_valid());
+
+    bitter::bit_stream_reader<bitter::lsb0> bulk(zeros.data(), zeros.size());
+    EXPECT_EQ(0U, bitter::rice_decode(bulk, values.data(), values.size(), 3));
+    EXPECT_FALSE(bulk.is_valid());
+
+    // A stream cut within the low bits of the third value
+    std::vector<uint8_t> data(8, 0);
+    bitter::bit_stream_writer<bitter::msb0> writer(data.data(), data.size());
+    bitter::rice_encode(writer, 5, 6);
+    bitter::rice_encode(writer, 9, 6);
+    bitter::rice_encode(writer, 7, 6);
+    writer.flush();
+
+    bitter::bit_stream_reader<bitter::msb0> cut(data.data(), 2);
+    EXPECT_EQ(2U, bitter::rice_decode(cut, values.data(), values.size(), 6));
+    EXPECT_EQ(5U, values[0]);
+    EXPECT_EQ(9U, values[1]);
+    EXPECT_FALSE(cut.is_valid());
+}
+
+template<class BitNumbering>
+void test_round_trip(uint32_t k)
+{
+    const uint32_t count = 1000;
+
+    std::vector<uint64_t> values(count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // Mostly values around 2^k with an occasional large one
+        values[i] = rand() % (uint64_t{1} << (k + 2));
+
+        if (i % 100 == 0)
+        {
+            values[i] = rand() % (uint64_t{1} << (k + 7));
+        }
+    }
+
+    std::vector<uint8_t> data(count * 16);
+    bitter::bit_stream_writer<BitNumbering> writer(data.data(), data.size());
+    bitter::rice_encode(writer, values.data(), count, k);
+    writer.flush();
+
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(values[i], bitter::rice_decode(reader, k));
+        }
+    }
+    {
+        bitter::bit_stream_reader<BitNumbering> reader(
+            data.data(), writer.size());
+
+        std::vector<uint64_t> decoded(count);
+        bitter::rice_decode(reader, decoded.data(), count, k);
+        EXPECT_EQ(values, decoded);
+        EXPECT_LT(reader.bits_left(), 8U);
+    }
+}
+
+TEST(test_rice, round_trip)
+{
+    test_round_trip<bitter::msb0>(0);
+    test_round_trip<bitter::msb0>(4);
+    test_round_trip<bitter::lsb0>(0);
+    test_round_trip<bitter::lsb0>(10);
+}
@@ -0,0 +1,70 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/split_columns.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_split_columns, lsb0)
+{
+    using header = bitter::lsb0_layout<uint32_t, 4, 12, 16>;
+
+    uint64_t count = 3000;
+    std::vector<uint32_t> headers(count);
+
+    for (auto& value : headers)
+    {
+        value = (uint32_t(rand()) << 16) ^ rand();
+    }
+
+    std::vector<uint8_t> version(count);
+    std::vector<uint16_t> length(count);
+    std::vector<uint64_t> id(count);
+
+    bitter::split_columns<header>(headers.data(), count, version.data(),
+                                  length.data(), id.data());
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        auto reader = header::reader_type(headers[i]);
+        ASSERT_EQ(reader.field<0>().as<uint8_t>(), version[i]);
+        ASSERT_EQ(reader.field<1>().as<uint16_t>(), length[i]);
+        ASSERT_EQ(reader.field<2>().as<uint64_t>(), id[i]);
+    }
+}
+
+TEST(test_split_columns, msb0)
+{
+    using record = bitter::msb0_layout<uint64_t, 1, 31, 32>;
+
+    std::vector<uint64_t> records = { 0x8000000100000002U, 0x7FFFFFFFFFFFFFFFU };
+    std::vector<uint32_t> first(2);
+    std::vector<uint32_t> second(2);
+
+    uint8_t flag[2];
+    bitter::split_columns<record>(records.data(), records.size(), flag,
+                                  first.data(), second.data());
+
+    EXPECT_EQ(1U, flag[0]);
+    EXPECT_EQ(0U, flag[1]);
+    EXPECT_EQ(1U, first[0]);
+    EXPECT_EQ(0x7FFFFFFFU, first[1]);
+    EXPECT_EQ(2U, second[0]);
+    EXPECT_EQ(0xFFFFFFFFU, second[1]);
+}
+
+TEST(test_split_columns, empty)
+{
+    using header = bitter::lsb0_layout<uint16_t, 8, 8>;
+
+    uint8_t* output = nullptr;
+    bitter::split_columns<header>(nullptr, 0, output, output);
+}
@@ -0,0 +1,145 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+#include <bitter/stream_decoder.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+template<class Layout>
+void check_random_chunks(uint64_t records, uint64_t max_chunk)
+{
+    std::vector<uint8_t> stream(records * Layout::bitter_type::size);
+
+    for (auto& byte : stream)
+    {
+        byte = static_cast<uint8_t>(rand());
+    }
+
+    // Decoded from the whole stream at once
+    std::vector<typename Layout::value_type> expected;
+    bitter::stream_decoder<Layout> whole;
+    whole.feed(stream.data(), stream.size(),
+               [&expected](typename Layout::value_type value)
+    {
+        expected.push_back(value);
+    });
+
+    ASSERT_EQ(records, expected.size());
+
+    // Fed in chunks of random size, copied so every chunk is gone after
+    // it was fed
+    std::vector<typename Layout::value_type> values;
+    bitter::stream_decoder<Layout> decoder;
+    uint64_t offset = 0;
+
+    while (offset < stream.size())
+    {
+        uint64_t size = std::min<uint64_t>(rand() % (max_chunk + 1),
+                                           stream.size() - offset);
+
+        std::vector<uint8_t> chunk(stream.begin() + offset,
+                                   stream.begin() + offset + size);
+
+        decoder.feed(chunk.data(), chunk.size());
+        typename Layout::value_type value;
+
+        while (decoder.next(value))
+        {
+            values.push_back(value);
+        }
+
+        offset += size;
+    }
+
+    EXPECT_EQ(0U, decoder.pending());
+    EXPECT_EQ(expected, values);
+}
+}
+
+TEST(test_stream_decoder, msb0)
+{
+    using record = bitter::msb0_layout<bitter::u24, 4, 20>;
+
+    std::vector<uint8_t> data = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE };
+    bitter::stream_decoder<record> decoder;
+
+    std::vector<uint32_t> values;
+    auto push = [&values](uint32_t value) { values.push_back(value); };
+
+    // The third record straddles the chunks
+    EXPECT_EQ(2U, decoder.feed(data.data(), data.size(), push));
+    EXPECT_EQ(1U, decoder.pending());
+
+    std::vector<uint8_t> rest = { 0xF0, 0x12 };
+    EXPECT_EQ(1U, decoder.feed(rest.data(), rest.size(), push));
+    EXPECT_EQ(0U, decoder.pending());
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0x123456, 0x789ABC, 0xDEF012 }), values);
+    EXPECT_EQ(0xEF012U, record::get<1>(values[2]));
+}
+
+TEST(test_stream_decoder, lsb0)
+{
+    using record = bitter::lsb0_layout<uint32_t, 16, 16>;
+
+    std::vector<uint8_t> data = { 0x01, 0x02, 0x03, 0x04 };
+    bitter::stream_decoder<record> decoder;
+    uint32_t value = 0;
+
+    // One byte at a time
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        decoder.feed(&data[i], 1);
+        EXPECT_FALSE(decoder.next(value));
+        EXPECT_EQ(i + 1, decoder.pending());
+    }
+
+    decoder.feed(&data[3], 1);
+    EXPECT_TRUE(decoder.next(value));
+    EXPECT_FALSE(decoder.next(value));
+    EXPECT_EQ(0x04030201U, value);
+
+    // Empty chunks
+    decoder.feed(nullptr, 0);
+    EXPECT_FALSE(decoder.next(value));
+}
+
+TEST(test_stream_decoder, reset)
+{
+    using record = bitter::msb0_layout<uint16_t, 16>;
+
+    std::vector<uint8_t> data = { 0xAA, 0xBB, 0xCC };
+    bitter::stream_decoder<record> decoder;
+    uint16_t value = 0;
+
+    decoder.feed(data.data(), data.size());
+    EXPECT_TRUE(decoder.next(value));
+    EXPECT_FALSE(decoder.next(value));
+    EXPECT_EQ(1U, decoder.pending());
+
+    decoder.reset();
+    EXPECT_EQ(0U, decoder.pending());
+
+    decoder.feed(data.data(), 2);
+    EXPECT_TRUE(decoder.next(value));
+    EXPECT_EQ(0xAABBU, value);
+}
+
+TEST(test_stream_decoder, random_chunks)
+{
+    check_random_chunks<bitter::msb0_layout<uint8_t, 8>>(1000, 5);
+    check_random_chunks<bitter::msb0_layout<bitter::u40, 8, 32>>(1000, 3);
+    check_random_chunks<bitter::msb0_layout<bitter::u40, 8, 32>>(1000, 100);
+    check_random_chunks<bitter::lsb0_layout<uint64_t, 32, 32>>(1000, 7);
+    check_random_chunks<bitter::lsb0_layout<uint64_t, 32, 32>>(1000, 1000);
+}
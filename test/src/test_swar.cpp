@@ -0,0 +1,117 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/swar.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+template<class Layout>
+typename Layout::value_type random_value()
+{
+    uint64_t value = (uint64_t(rand()) << 40) ^ (uint64_t(rand()) << 20) ^
+                     rand();
+    uint64_t all = bitter::detail::lane_masks<Layout>::all();
+
+    return static_cast<typename Layout::value_type>(value & all);
+}
+
+// Checks every operation against per field reads and writes
+template<class Layout>
+void check()
+{
+    using value_type = typename Layout::value_type;
+    using swar = bitter::swar<Layout>;
+    using table = typename Layout::table;
+
+    for (uint32_t n = 0; n < 1000; ++n)
+    {
+        value_type a = random_value<Layout>();
+        value_type b = n % 3 == 0 ? a : random_value<Layout>();
+
+        value_type add = swar::add(a, b);
+        value_type sub = swar::sub(a, b);
+        value_type add_saturate = swar::add_saturate(a, b);
+        value_type sub_saturate = swar::sub_saturate(a, b);
+        value_type increment = swar::increment(a);
+        value_type eq = swar::compare_eq(a, b);
+        value_type lt = swar::compare_lt(a, b);
+        value_type le = swar::compare_le(a, b);
+        value_type min = swar::min(a, b);
+        value_type max = swar::max(a, b);
+
+        uint64_t sum = 0;
+
+        for (uint32_t i = 0; i < Layout::fields; ++i)
+        {
+            uint64_t x = table::get(a, i);
+            uint64_t y = table::get(b, i);
+            uint64_t mask = table::mask(i);
+
+            sum += x;
+
+            ASSERT_EQ((x + y) & mask, table::get(add, i));
+            ASSERT_EQ((x - y) & mask, table::get(sub, i));
+            ASSERT_EQ(x > mask - y ? mask : x + y, table::get(add_saturate, i));
+            ASSERT_EQ(x > y ? x - y : 0, table::get(sub_saturate, i));
+            ASSERT_EQ((x + 1) & mask, table::get(increment, i));
+            ASSERT_EQ(x == y ? mask : 0, table::get(eq, i));
+            ASSERT_EQ(x < y ? mask : 0, table::get(lt, i));
+            ASSERT_EQ(x <= y ? mask : 0, table::get(le, i));
+            ASSERT_EQ(std::min(x, y), table::get(min, i));
+            ASSERT_EQ(std::max(x, y), table::get(max, i));
+        }
+
+        ASSERT_EQ(sum, swar::horizontal_sum(a));
+    }
+}
+}
+
+TEST(test_swar, counters)
+{
+    using counters = bitter::swar<bitter::lsb0_layout<uint64_t,
+                     8, 8, 8, 8, 8, 8, 8, 8>>;
+
+    uint64_t value = counters::broadcast(0xFE);
+    EXPECT_EQ(0xFEFEFEFEFEFEFEFEU, value);
+
+    value = counters::add_saturate(value, counters::broadcast(1));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFU, value);
+
+    value = counters::add_saturate(value, counters::broadcast(1));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFU, value);
+
+    value = counters::increment(value);
+    EXPECT_EQ(0U, value);
+
+    EXPECT_EQ(36U, counters::horizontal_sum(0x0807060504030201U));
+    EXPECT_EQ(0xFF00FF00FF00FF00U,
+              counters::compare_lt(0x0001000100010001U, 0x0100010001000100U));
+}
+
+TEST(test_swar, uniform)
+{
+    check<bitter::lsb0_layout<uint64_t, 8, 8, 8, 8, 8, 8, 8, 8>>();
+    check<bitter::lsb0_layout<uint64_t, 4, 4, 4, 4, 4, 4, 4, 4,
+                              4, 4, 4, 4, 4, 4, 4, 4>>();
+    check<bitter::msb0_layout<uint32_t, 16, 16>>();
+    check<bitter::lsb0_layout<uint8_t, 1, 1, 1, 1, 1, 1, 1, 1>>();
+    check<bitter::lsb0_layout<bitter::u24, 8, 8, 8>>();
+    check<bitter::lsb0_layout<uint64_t, 64>>();
+}
+
+TEST(test_swar, non_uniform)
+{
+    check<bitter::lsb0_layout<uint32_t, 1, 7, 8, 16>>();
+    check<bitter::msb0_layout<uint64_t, 3, 5, 12, 12, 32>>();
+    check<bitter::lsb0_layout<uint16_t, 4, 8, 4>>();
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/transcode.hpp>
+#include <bitter/lsb0_layout.hpp>
+#include <bitter/msb0_layout.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(test_transcode, reorder)
+{
+    using internal = bitter::lsb0_layout<uint32_t, 8, 8, 16>;
+    using wire = bitter::msb0_layout<uint32_t, 16, 8, 8>;
+    using mapping = bitter::field_map<2, 0, 1>;
+
+    uint32_t value = internal::set<0>(0, 0x12);
+    value = internal::set<1>(value, 0x34);
+    value = internal::set<2>(value, 0xABCD);
+
+    uint32_t out = bitter::transcode<internal, wire, mapping>(value);
+
+    EXPECT_EQ(0xABCD1234U, out);
+    EXPECT_EQ(0xABCDU, wire::get<0>(out));
+    EXPECT_EQ(0x12U, wire::get<1>(out));
+    EXPECT_EQ(0x34U, wire::get<2>(out));
+
+    // And back again
+    using inverse = bitter::field_map<1, 2, 0>;
+    EXPECT_EQ(value, (bitter::transcode<wire, internal, inverse>(out)));
+}
+
+TEST(test_transcode, widths)
+{
+    // Widening and narrowing fields and a zero field
+    using from = bitter::msb0_layout<bitter::u24, 4, 12, 8>;
+    using to = bitter::lsb0_layout<uint64_t, 16, 16, 8, 24>;
+    using mapping = bitter::field_map<1, 0, 2, bitter::no_field>;
+
+    uint32_t value = 0x123456;
+    uint64_t out = bitter::transcode<from, to, mapping>(value);
+
+    EXPECT_EQ(0x234U, to::get<0>(out));
+    EXPECT_EQ(0x1U, to::get<1>(out));
+    EXPECT_EQ(0x56U, to::get<2>(out));
+    EXPECT_EQ(0U, to::get<3>(out));
+
+    using back = bitter::field_map<1, 0, 2>;
+    EXPECT_EQ(value, (bitter::transcode<to, from, back>(out)));
+}
+
+TEST(test_transcode, bulk)
+{
+    using from = bitter::lsb0_layout<uint32_t, 3, 5, 7, 17>;
+    using to = bitter::msb0_layout<uint32_t, 7, 17, 5, 3>;
+    using mapping = bitter::field_map<2, 3, 1, 0>;
+
+    std::vector<uint32_t> input(1000);
+
+    for (auto& value : input)
+    {
+        value = (uint32_t(rand()) << 16) ^ rand();
+    }
+
+    std::vector<uint32_t> output(input.size());
+    bitter::transcode<from, to, mapping>(input.data(), input.size(),
+                                         output.data());
+
+    for (uint32_t i = 0; i < input.size(); ++i)
+    {
+        auto reader = from::reader_type(input[i]);
+
+        to::writer_type writer;
+        writer.field<0>(reader.field<2>().as<uint32_t>());
+        writer.field<1>(reader.field<3>().as<uint32_t>());
+        writer.field<2>(reader.field<1>().as<uint32_t>());
+        writer.field<3>(reader.field<0>().as<uint32_t>());
+
+        ASSERT_EQ(writer.data(), output[i]);
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/msb0_layout.hpp>
+#include <bitter/variant_layout.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// A 4 bit type followed by either a 28 bit counter, a 12 bit id and 16
+// bit length, or (for type 2) the same fields as type 0
+using counter = bitter::msb0_layout<uint32_t, 4, 28>;
+using packet = bitter::msb0_layout<uint32_t, 4, 12, 16>;
+
+using tag = bitter::tag_field<counter, 0>;
+using frame = bitter::variant_layout<tag, counter, packet, counter>;
+
+// Records the decoded fields of every visited value
+struct recorder
+{
+    template<class Index>
+    void operator()(Index index, counter::reader_type reader)
+    {
+        tags.push_back(index);
+        fields.push_back(reader.field<1>().as<uint32_t>());
+    }
+
+    template<class Index>
+    void operator()(Index index, packet::reader_type reader)
+    {
+        static_assert(Index::value == 1, "");
+
+        tags.push_back(index);
+        fields.push_back(reader.field<1>().as<uint32_t>() +
+                         reader.field<2>().as<uint32_t>());
+    }
+
+    std::vector<uint32_t> tags;
+    std::vector<uint32_t> fields;
+};
+}
+
+TEST(test_variant_layout, tag)
+{
+    EXPECT_EQ(3U, frame::layouts);
+    EXPECT_EQ(0U, frame::tag(0x01234567));
+    EXPECT_EQ(1U, frame::tag(0x11234567));
+    EXPECT_EQ(15U, frame::tag(0xF1234567));
+
+    EXPECT_TRUE(frame::is_valid(0x21234567));
+    EXPECT_FALSE(frame::is_valid(0x31234567));
+
+    EXPECT_TRUE((std::is_same<frame::layout_type<1>, packet>::value));
+}
+
+TEST(test_variant_layout, visit)
+{
+    recorder visitor;
+
+    EXPECT_TRUE(frame::visit(0x00000010U, visitor));
+    EXPECT_TRUE(frame::visit(0x10020003U, visitor));
+    EXPECT_TRUE(frame::visit(0x20000020U, visitor));
+    EXPECT_FALSE(frame::visit(0xF0000000U, visitor));
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0, 1, 2 }), visitor.tags);
+    EXPECT_EQ(std::vector<uint32_t>({ 0x10, 5, 0x20 }), visitor.fields);
+
+    // A generic lambda is instantiated for every layout
+    uint32_t id = 0;
+
+    frame::visit(0x10020003U, [&id](auto index, auto reader)
+    {
+        EXPECT_EQ(1U, index);
+        id = reader.template field<1>().template as<uint32_t>();
+    });
+
+    EXPECT_EQ(2U, id);
+}
+
+TEST(test_variant_layout, partition)
+{
+    std::vector<uint32_t> values =
+    {
+        0x10000001U, 0x00000002U, 0xF0000003U, 0x20000004U, 0x10000005U,
+        0x00000006U, 0x50000007U
+    };
+
+    std::vector<uint32_t> output(values.size());
+    uint64_t offsets[frame::layouts + 2];
+
+    frame::partition(values.data(), values.size(), output.data(), offsets);
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0x00000002U, 0x00000006U,
+                                      0x10000001U, 0x10000005U,
+                                      0x20000004U,
+                                      0xF0000003U, 0x50000007U }), output);
+
+    EXPECT_EQ(0U, offsets[0]);
+    EXPECT_EQ(2U, offsets[1]);
+    EXPECT_EQ(4U, offsets[2]);
+    EXPECT_EQ(5U, offsets[3]);
+    EXPECT_EQ(7U, offsets[4]);
+}
+
+TEST(test_variant_layout, bulk_visit)
+{
+    std::vector<uint32_t> values;
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        values.push_back(((i % 5) << 28) | i);
+    }
+
+    std::vector<uint32_t> scratch(values.size());
+    recorder visitor;
+
+    uint64_t invalid = frame::visit(values.data(), values.size(),
+                                    scratch.data(), visitor);
+
+    EXPECT_EQ(400U, invalid);
+    ASSERT_EQ(600U, visitor.tags.size());
+
+    // Every group in order, the values of a group in their original order
+    recorder expected;
+
+    for (uint32_t tag = 0; tag < frame::layouts; ++tag)
+    {
+        for (uint32_t value : values)
+        {
+            if (frame::tag(value) == tag)
+            {
+                frame::visit(value, expected);
+            }
+        }
+    }
+
+    EXPECT_EQ(expected.tags, visitor.tags);
+    EXPECT_EQ(expected.fields, visitor.fields);
+
+    EXPECT_EQ(0U, frame::visit(nullptr, 0, nullptr, visitor));
+}
+
+TEST(test_variant_layout, sparse_tags)
+{
+    // The 4 bit IP version selects the layout of the first word
+    using ipv4 = bitter::msb0_layout<uint32_t, 4, 4, 8, 16>;
+    using ipv6 = bitter::msb0_layout<uint32_t, 4, 8, 20>;
+
+    using ip = bitter::variant_layout<bitter::tag_field<ipv4, 0>,
+          bitter::variant_case<6, ipv6>, bitter::variant_case<4, ipv4>>;
+
+    static_assert(ip::layouts == 2, "");
+    static_assert(ip::tags == 16, "");
+    static_assert(ip::case_tag<0>() == 6, "");
+    static_assert(std::is_same<ip::layout_type<1>, ipv4>::value, "");
+
+    EXPECT_TRUE(ip::is_valid(0x45000054U));
+    EXPECT_TRUE(ip::is_valid(0x60012345U));
+    EXPECT_FALSE(ip::is_valid(0x00000000U));
+    EXPECT_FALSE(ip::is_valid(0x50000000U));
+
+    std::vector<uint32_t> tags;
+    std::vector<uint32_t> fields;
+
+    auto visitor = [&tags, &fields](auto tag, auto reader)
+    {
+        tags.push_back(tag);
+        fields.push_back(reader.template field<2>().template as<uint32_t>());
+    };
+
+    EXPECT_TRUE(ip::visit(0x45000054U, visitor));
+    EXPECT_TRUE(ip::visit(0x60012345U, visitor));
+    EXPECT_FALSE(ip::visit(0xF0000000U, visitor));
+
+    EXPECT_EQ(std::vector<uint32_t>({ 4, 6 }), tags);
+    EXPECT_EQ(std::vector<uint32_t>({ 0x00, 0x12345 }), fields);
+
+    // The groups follow the order of the layouts
+    std::vector<uint32_t> values =
+    {
+        0x45000001U, 0x60000002U, 0x10000003U, 0x45000004U, 0x60000005U
+    };
+    std::vector<uint32_t> output(values.size());
+    uint64_t offsets[ip::layouts + 2];
+
+    ip::partition(values.data(), values.size(), output.data(), offsets);
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0x60000002U, 0x60000005U,
+                                      0x45000001U, 0x45000004U,
+                                      0x10000003U }), output);
+    EXPECT_EQ(2U, offsets[1]);
+    EXPECT_EQ(4U, offsets[2]);
+    EXPECT_EQ(5U, offsets[3]);
+
+    tags.clear();
+    fields.clear();
+
+    EXPECT_EQ(1U, ip::visit(values.data(), values.size(), output.data(),
+                            visitor));
+    EXPECT_EQ(std::vector<uint32_t>({ 6, 6, 4, 4 }), tags);
+}
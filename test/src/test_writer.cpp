@@ -221,3 +221,55 @@ TEST(test_bit_writer, write_bit_5)
         EXPECT_EQ(value, 0x11223344U);
     }
 }
+
+TEST(test_bit_writer, write_runtime_index)
+{
+    {
+        auto writer = bitter::lsb0_writer<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>();
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            writer.field(i, i + 1);
+        }
+
+        EXPECT_EQ(0x87654321U, writer.data());
+    }
+    {
+        auto writer = bitter::msb0_writer<uint32_t, 4, 4, 4, 4, 4, 4, 4, 4>();
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            writer.field(i, i + 1);
+        }
+
+        EXPECT_EQ(0x12345678U, writer.data());
+    }
+    {
+        auto writer = bitter::msb0_writer<bitter::u24, 4, 12, 8>();
+        writer.field(0, 0x1);
+        writer.field(1, 0x234);
+        writer.field(2, 0x56);
+
+        EXPECT_EQ(0x123456U, writer.data());
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST(test_bit_writer, write_bit_u128)
+{
+    auto writer = bitter::msb0_writer<bitter::u128, 48, 16, 64>();
+    writer.field<0>(0x20010DB8AC10U);
+    writer.field<1>(0x0001U);
+    writer.field<2>(0x42U);
+
+    bitter::uint128_t expected =
+        (bitter::uint128_t(0x20010DB8AC100001U) << 64) | 0x42U;
+
+    EXPECT_TRUE(expected == writer.data());
+
+    auto lsb0 = bitter::lsb0_writer<bitter::u80, 40, 40>();
+    lsb0.field(1, 0xFFFFFFFFFFU);
+
+    EXPECT_TRUE((bitter::uint128_t(0xFFFFFFFFFFU) << 40) == lsb0.data());
+}
+#endif
@@ -0,0 +1,39 @@
+// Copyright (c) Steinwurf ApS 2016.
+// All Rights Reserved
+//
+// Distributed under the "BSD License". See the accompanying LICENSE.rst file.
+
+#include <bitter/zigzag.hpp>
+
+#include <cstdint>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+TEST(test_zigzag, encode)
+{
+    EXPECT_EQ(0U, bitter::zigzag_encode(int64_t{0}));
+    EXPECT_EQ(1U, bitter::zigzag_encode(int64_t{-1}));
+    EXPECT_EQ(2U, bitter::zigzag_encode(int64_t{1}));
+    EXPECT_EQ(3U, bitter::zigzag_encode(int64_t{-2}));
+    EXPECT_EQ(4U, bitter::zigzag_encode(int64_t{2}));
+
+    EXPECT_EQ(0xFFFFFFFFU, bitter::zigzag_encode(
+                  std::numeric_limits<int32_t>::min()));
+    EXPECT_EQ(0xFFFFFFFEU, bitter::zigzag_encode(
+                  std::numeric_limits<int32_t>::max()));
+}
+
+TEST(test_zigzag, round_trip)
+{
+    for (int32_t i = -1000; i <= 1000; ++i)
+    {
+        EXPECT_EQ(i, bitter::zigzag_decode(bitter::zigzag_encode(i)));
+    }
+
+    int64_t min = std::numeric_limits<int64_t>::min();
+    int64_t max = std::numeric_limits<int64_t>::max();
+
+    EXPECT_EQ(min, bitter::zigzag_decode(bitter::zigzag_encode(min)));
+    EXPECT_EQ(max, bitter::zigzag_decode(bitter::zigzag_encode(max)));
+}